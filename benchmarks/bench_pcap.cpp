@@ -0,0 +1,253 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <netbox/PcapPacketSource.h>
+#include <netbox/pcap/MappedReader.h>
+#include <netbox/pcap/Reader.h>
+#include <netbox/pcap/Writer.h>
+
+using namespace netbox;
+
+namespace {
+
+constexpr std::size_t PacketCount = 1000000;
+
+/// Path to PCAP file with `PacketCount` market data sized packets
+const char* pcapFile()
+{
+    static const std::string path = [] {
+        std::string path = "/tmp/netbox_bench.pcap";
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            std::abort();
+        }
+
+        pcap::FileHeader fileHeader{};
+        fileHeader.magic = pcap::NSecTCPDumpMagic;
+        fileHeader.version_major = 2;
+        fileHeader.version_minor = 4;
+        fileHeader.snaplen = pcap::MaxSnapLen;
+        fileHeader.linktype = pcap::Ethernet;
+        std::fwrite(&fileHeader, sizeof(fileHeader), 1, file);
+
+        std::vector< char > data(1500, 'x');
+        for (std::size_t i = 0; i < PacketCount; ++i) {
+            pcap::PacketHeader header{};
+            header.ts_sec = i / 1000;
+            header.ts_usec = (i % 1000) * 1000;
+            header.caplen = 60 + (i * 7) % 1000;
+            header.len = header.caplen;
+            std::fwrite(&header, sizeof(header), 1, file);
+            std::fwrite(data.data(), header.caplen, 1, file);
+        }
+
+        std::fclose(file);
+        std::atexit([] { std::remove("/tmp/netbox_bench.pcap"); });
+        return path;
+    }();
+
+    return path.c_str();
+}
+
+constexpr std::size_t MergeFileCount = 200;
+constexpr std::size_t MergePacketCount = 2000;
+
+/// Paths to `MergeFileCount` PCAP files with interleaved timestamps
+const std::vector< std::string >& mergeFiles()
+{
+    static const std::vector< std::string > paths = [] {
+        std::vector< std::string > paths;
+        std::vector< char > data(60, 'x');
+        for (std::size_t file = 0; file < MergeFileCount; ++file) {
+            paths.push_back("/tmp/netbox_bench_merge_" + std::to_string(file) + ".pcap");
+
+            std::FILE* stream = std::fopen(paths.back().c_str(), "wb");
+            if (!stream) {
+                std::abort();
+            }
+
+            pcap::FileHeader fileHeader{};
+            fileHeader.magic = pcap::NSecTCPDumpMagic;
+            fileHeader.version_major = 2;
+            fileHeader.version_minor = 4;
+            fileHeader.snaplen = pcap::MaxSnapLen;
+            fileHeader.linktype = pcap::Ethernet;
+            std::fwrite(&fileHeader, sizeof(fileHeader), 1, stream);
+
+            for (std::size_t i = 0; i < MergePacketCount; ++i) {
+                // Short runs of packets per file
+                const std::size_t time = (i / 4) * MergeFileCount + file;
+                pcap::PacketHeader header{};
+                header.ts_sec = time / 1000000000;
+                header.ts_usec = time % 1000000000;
+                header.caplen = data.size();
+                header.len = header.caplen;
+                std::fwrite(&header, sizeof(header), 1, stream);
+                std::fwrite(data.data(), header.caplen, 1, stream);
+            }
+
+            std::fclose(stream);
+        }
+        std::atexit([] {
+            for (std::size_t file = 0; file < MergeFileCount; ++file) {
+                std::remove(("/tmp/netbox_bench_merge_" + std::to_string(file) + ".pcap").c_str());
+            }
+        });
+        return paths;
+    }();
+
+    return paths;
+}
+
+template< class Reader >
+void BM_ReadPacket(benchmark::State& state)
+{
+    const char* path = pcapFile();
+    std::size_t count = 0;
+    for (auto _: state) {
+        Reader reader{path};
+        while (auto packet = reader.readPacket()) {
+            benchmark::DoNotOptimize(packet.data());
+            count += 1;
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+
+template< class Reader >
+void BM_ReadBatch(benchmark::State& state)
+{
+    const std::size_t batchSize = state.range(0);
+    const char* path = pcapFile();
+    std::size_t count = 0;
+    for (auto _: state) {
+        Reader reader{path};
+        while (true) {
+            auto batch = reader.readBatch(batchSize);
+            if (batch.empty()) {
+                break;
+            }
+            for (auto& packet: batch) {
+                benchmark::DoNotOptimize(packet.data());
+            }
+            count += batch.size();
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+
+void BM_SourceReadNextPacket(benchmark::State& state)
+{
+    const char* path = pcapFile();
+    std::size_t count = 0;
+    for (auto _: state) {
+        PcapPacketSource source;
+        source.addFile(path);
+        while (auto packet = source.readNextPacket()) {
+            benchmark::DoNotOptimize(packet.data());
+            count += 1;
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+
+void BM_SourceReadBatch(benchmark::State& state)
+{
+    const std::size_t batchSize = state.range(0);
+    const char* path = pcapFile();
+    std::size_t count = 0;
+    for (auto _: state) {
+        PcapPacketSource source;
+        source.addFile(path);
+        while (true) {
+            auto batch = source.readBatch(batchSize);
+            if (batch.empty()) {
+                break;
+            }
+            for (auto& packet: batch) {
+                benchmark::DoNotOptimize(packet.data());
+            }
+            count += batch.size();
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+
+void BM_SourceMerge(benchmark::State& state)
+{
+    const std::size_t fileCount = state.range(0);
+    PcapPacketSourceOptions options;
+    options.prefetchThreads = state.range(1);
+
+    const auto& paths = mergeFiles();
+    std::size_t count = 0;
+    for (auto _: state) {
+        PcapPacketSource source{options};
+        for (std::size_t i = 0; i < fileCount; ++i) {
+            source.addFile(paths[i].c_str());
+        }
+        while (auto packet = source.readNextPacket()) {
+            benchmark::DoNotOptimize(packet.data());
+            count += 1;
+        }
+    }
+    state.SetItemsProcessed(count);
+}
+
+void BM_Write(benchmark::State& state)
+{
+    // Arg 0 - compression (0 none, 1 zstd), arg 1 - compression thread
+    const char* path = state.range(0) == 0 ? "/tmp/netbox_bench_out.pcap" : "/tmp/netbox_bench_out.pcap.zst";
+    utils::FileWriterOptions options;
+    options.compressThread = state.range(1) != 0;
+
+    pcap::MappedReader reader{pcapFile()};
+    std::vector< pcap::Packet > packets;
+    while (auto packet = reader.readPacket()) {
+        packets.push_back(packet);
+    }
+
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+    for (auto _: state) {
+        pcap::Writer writer{path, options};
+        for (auto& packet: packets) {
+            writer.write(packet);
+            bytes += sizeof(pcap::PacketHeader) + packet.captureLength();
+        }
+        writer.close();
+        count += packets.size();
+    }
+    std::remove(path);
+    state.SetItemsProcessed(count);
+    state.SetBytesProcessed(bytes);
+}
+
+} /* namespace */
+
+BENCHMARK_TEMPLATE(BM_ReadPacket, pcap::Reader)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReadBatch, pcap::Reader)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReadPacket, pcap::MappedReader)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReadBatch, pcap::MappedReader)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SourceReadNextPacket)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SourceReadBatch)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SourceMerge)
+    ->ArgsProduct({{2, 50, 200}, {0, 1, 4}})
+    ->ArgNames({"files", "prefetch"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_Write)
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->ArgNames({"zstd", "thread"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
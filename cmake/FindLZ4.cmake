@@ -0,0 +1,18 @@
+# Find LZ4 library
+#
+# LZ4_FOUND - system has lz4
+# LZ4_INCLUDE_DIRS - the lz4 include directory
+# LZ4_LIBRARIES - link these to use lz4
+
+find_path(LZ4_INCLUDE_DIR NAMES lz4frame.h)
+find_library(LZ4_LIBRARY NAMES lz4)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4 DEFAULT_MSG LZ4_LIBRARY LZ4_INCLUDE_DIR)
+
+if (LZ4_FOUND)
+    set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+    set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+endif()
+
+mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARY)
@@ -0,0 +1,18 @@
+# Find Zstandard library
+#
+# ZSTD_FOUND - system has zstd
+# ZSTD_INCLUDE_DIRS - the zstd include directory
+# ZSTD_LIBRARIES - link these to use zstd
+
+find_path(ZSTD_INCLUDE_DIR NAMES zstd.h)
+find_library(ZSTD_LIBRARY NAMES zstd)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD DEFAULT_MSG ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+if (ZSTD_FOUND)
+    set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+    set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+endif()
+
+mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARY)
@@ -25,6 +25,6 @@ target_link_libraries(benchmark INTERFACE
 add_dependencies(benchmark googlebenchmark)
 
 add_library(benchmark_main INTERFACE)
-target_link_libraries(benchmark INTERFACE
+target_link_libraries(benchmark_main INTERFACE
     ${binary_dir}/src/${CMAKE_FIND_LIBRARY_PREFIXES}benchmark_main${CMAKE_STATIC_LIBRARY_SUFFIX}
     benchmark)
@@ -0,0 +1,44 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <iostream>
+#include <netbox/PcapPacketSource.h>
+#include <netbox/pcap/Writer.h>
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <output.pcap[.gz|.zst]> <input>...\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        netbox::PcapPacketSource source;
+        for (int i = 2; i < argc; ++i) {
+            source.addFile(argv[i]);
+        }
+
+        netbox::utils::FileWriterOptions options;
+        options.compressThread = true;
+        netbox::pcap::Writer writer{argv[1], options};
+
+        std::size_t count{0};
+        while (true) {
+            auto batch = source.readBatch(256);
+            if (batch.empty()) {
+                break;
+            }
+            writer.write(batch);
+            count += batch.size();
+        }
+        writer.close();
+
+        std::cout << "Written " << count << " packets\n";
+
+    } catch (const std::exception& e) {
+        std::cout << "ERROR: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
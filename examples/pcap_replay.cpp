@@ -0,0 +1,63 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <chrono>
+#include <iostream>
+#include <netbox/PacketTxRing.h>
+#include <netbox/PcapPacketSource.h>
+
+using namespace netbox;
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <interface> <input>...\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        PcapPacketSource source;
+        for (int i = 2; i < argc; ++i) {
+            source.addFile(argv[i]);
+        }
+
+        PacketTxRingOptions options;
+        options.interface = argv[1];
+        options.qdiscBypass = true;
+        PacketTxRing ring{options};
+
+        // Replay as fast as possible, one send() per batch
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t count{0};
+        std::size_t skipped{0};
+        while (true) {
+            auto batch = source.readBatch(256);
+            if (batch.empty()) {
+                break;
+            }
+            for (auto& packet: batch) {
+                if (packet.captureLength() > ring.maxPacketSize()) {
+                    skipped += 1;
+                    continue;
+                }
+                while (!ring.write(packet)) {
+                    ring.flush();
+                    ring.wait();
+                }
+                count += 1;
+            }
+            ring.flush();
+        }
+        ring.flush(true);
+
+        const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Sent " << count << " packets (" << skipped << " skipped) at "
+            << std::size_t(count / elapsed.count()) << " packets/s\n";
+
+    } catch (const std::exception& e) {
+        std::cout << "ERROR: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
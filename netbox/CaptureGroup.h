@@ -0,0 +1,157 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_CaptureGroup_181026183320
+#define KSERGEY_CaptureGroup_181026183320
+
+#include <unistd.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <netbox/details/WorkerGroup.h>
+#include <netbox/exception.h>
+#include <netbox/PacketRing.h>
+#include <netbox/pcap/PacketBatch.h>
+
+namespace netbox {
+
+/// CaptureGroup tuning
+struct CaptureGroupOptions
+{
+    /// Tuning of each member ring
+    PacketRingOptions ring;
+
+    /// Number of member rings (and worker threads)
+    std::size_t members{1};
+
+    /// Packets distribution mode
+    FanoutMode mode{FanoutMode::Hash};
+
+    /// Reassemble IP fragments before hashing
+    bool defrag{false};
+
+    /// Fanout group identifier, 0 - unique for the process
+    std::uint16_t groupId{0};
+
+    /// CPU to pin worker `i` to is `cpus[i % cpus.size()]`, empty - no pinning
+    std::vector< int > cpus;
+
+    /// Maximum number of packets passed to handler at once
+    std::size_t batchSize{256};
+
+    /// Time to wait for packets before checking stop request (milliseconds)
+    int pollTimeout{100};
+};
+
+/// Multi-core live capture
+/// Group of `PacketRing`s joined with PACKET_FANOUT, each ring is read
+/// by its own (optionally pinned) worker thread.
+class CaptureGroup
+{
+private:
+    CaptureGroupOptions options_;
+    std::vector< std::unique_ptr< PacketRing > > rings_;
+    // Guards ring statistics
+    std::mutex mutex_;
+    // Declared after rings, so workers stopped before rings destroyed
+    details::WorkerGroup workers_;
+
+public:
+    CaptureGroup(const CaptureGroup&) = delete;
+    CaptureGroup& operator=(const CaptureGroup&) = delete;
+
+    /// Create member rings and join them into fanout group
+    /// @param[in] options is group tuning
+    /// @throw SocketError, SocketOptionError on error
+    explicit CaptureGroup(const CaptureGroupOptions& options)
+        : options_{options}
+        , workers_{std::max< std::size_t >(options.members, 1)}
+    {
+        const std::uint16_t id = options_.groupId != 0 ? options_.groupId : uniqueGroupId();
+        for (std::size_t i = 0; i < std::max< std::size_t >(options_.members, 1); ++i) {
+            rings_.push_back(std::make_unique< PacketRing >(options_.ring));
+            rings_.back()->joinFanout(id, options_.mode, options_.defrag);
+        }
+    }
+
+    /// Destructor, stops workers
+    ~CaptureGroup() noexcept
+    {
+        workers_.shutdown();
+    }
+
+    /// Return number of members
+    std::size_t size() const noexcept
+    {
+        return rings_.size();
+    }
+
+    /// Return ring of member
+    /// @pre `index < size()`
+    PacketRing& ring(std::size_t index) noexcept
+    {
+        return *rings_[index];
+    }
+
+    /// Start worker threads, running workers are stopped first
+    /// Worker `i` calls `handler(i, batch)` for each batch of packets read from ring `i`,
+    /// packets are valid until the handler returns. The handler is copied per worker,
+    /// a worker stops on exception raised by its handler.
+    /// @param[in] handler is callable `void(std::size_t, pcap::PacketBatch)`
+    template< class Handler >
+    void start(Handler handler)
+    {
+        workers_.start(options_.cpus, [this, handler](std::size_t index) mutable {
+            PacketRing& ring = *rings_[index];
+            if (!ring.wait(options_.pollTimeout)) {
+                return;
+            }
+            if (auto batch = ring.readBatch(options_.batchSize); !batch.empty()) {
+                handler(index, batch);
+            }
+        });
+    }
+
+    /// Stop and join worker threads
+    /// @throw Rethrow the first exception raised by a handler
+    void stop()
+    {
+        workers_.stop();
+    }
+
+    /// Return capture counters of member since the group created
+    /// @throw SocketOptionError on error
+    PacketRingStatistics statistics(std::size_t index)
+    {
+        std::lock_guard< std::mutex > lock{mutex_};
+        return rings_[index]->statistics();
+    }
+
+    /// Return capture counters of all members
+    /// @throw SocketOptionError on error
+    PacketRingStatistics statistics()
+    {
+        PacketRingStatistics result;
+        for (std::size_t i = 0; i < rings_.size(); ++i) {
+            auto statistics = this->statistics(i);
+            result.packets += statistics.packets;
+            result.drops += statistics.drops;
+            result.freezes += statistics.freezes;
+        }
+        return result;
+    }
+
+private:
+    static std::uint16_t uniqueGroupId() noexcept
+    {
+        static std::atomic< std::uint16_t > counter{0};
+        return std::uint16_t(::getpid() + counter.fetch_add(1, std::memory_order_relaxed));
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_CaptureGroup_181026183320 */
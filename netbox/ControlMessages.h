@@ -0,0 +1,203 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ControlMessages_181026195318
+#define KSERGEY_ControlMessages_181026195318
+
+#include <linux/errqueue.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <cstring>
+#include <ctime>
+
+namespace netbox {
+
+/// Control message (ancillary data) of received message
+class ControlMessage
+{
+private:
+    const cmsghdr* cmsg_;
+
+public:
+    /// Construct from native control message
+    constexpr explicit ControlMessage(const cmsghdr* cmsg) noexcept
+        : cmsg_{cmsg}
+    {}
+
+    /// Return control message level (`SOL_SOCKET`, `SOL_IP`, ...)
+    int level() const noexcept
+    {
+        return cmsg_->cmsg_level;
+    }
+
+    /// Return control message type (`SCM_TIMESTAMPNS`, ...)
+    int type() const noexcept
+    {
+        return cmsg_->cmsg_type;
+    }
+
+    /// Return true if control message of `level` and `type`
+    bool is(int level, int type) const noexcept
+    {
+        return cmsg_->cmsg_level == level && cmsg_->cmsg_type == type;
+    }
+
+    /// Return control message payload
+    const void* data() const noexcept
+    {
+        return CMSG_DATA(cmsg_);
+    }
+
+    /// Return control message payload size
+    std::size_t size() const noexcept
+    {
+        return cmsg_->cmsg_len - CMSG_LEN(0);
+    }
+
+    /// Copy payload into `value`
+    /// @return False if payload is smaller than `T`
+    template< class T >
+    bool get(T& value) const noexcept
+    {
+        if (size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data(), sizeof(T));
+        return true;
+    }
+};
+
+/// Range of control messages of received message
+/// Walks control buffer in place, no allocations
+class ControlMessages
+{
+private:
+    const msghdr* header_;
+
+public:
+    /// Control messages iterator
+    class Iterator
+    {
+    private:
+        const msghdr* header_{nullptr};
+        const cmsghdr* cmsg_{nullptr};
+
+    public:
+        constexpr Iterator() = default;
+
+        Iterator(const msghdr* header, const cmsghdr* cmsg) noexcept
+            : header_{header}
+            , cmsg_{cmsg}
+        {}
+
+        ControlMessage operator*() const noexcept
+        {
+            return ControlMessage{cmsg_};
+        }
+
+        Iterator& operator++() noexcept
+        {
+            cmsg_ = CMSG_NXTHDR(const_cast< msghdr* >(header_), const_cast< cmsghdr* >(cmsg_));
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return cmsg_ == other.cmsg_;
+        }
+
+        bool operator!=(const Iterator& other) const noexcept
+        {
+            return cmsg_ != other.cmsg_;
+        }
+    };
+
+    /// Construct control messages range of `header`
+    /// `header.msg_controllen` should be set by receive call
+    constexpr explicit ControlMessages(const msghdr& header) noexcept
+        : header_{&header}
+    {}
+
+    Iterator begin() const noexcept
+    {
+        return {header_, CMSG_FIRSTHDR(header_)};
+    }
+
+    Iterator end() const noexcept
+    {
+        return {};
+    }
+};
+
+/// Receive timestamps of message
+struct ReceiveTimestamps
+{
+    /// Software timestamp (`SO_TIMESTAMP`, `SO_TIMESTAMPNS` or
+    /// `SO_TIMESTAMPING` with `SOF_TIMESTAMPING_RX_SOFTWARE`), zero if none
+    timespec software{0, 0};
+
+    /// Raw hardware timestamp (`SO_TIMESTAMPING` with
+    /// `SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE`), zero if none
+    timespec hardware{0, 0};
+
+    /// Return true if software timestamp present
+    bool hasSoftware() const noexcept
+    {
+        return software.tv_sec != 0 || software.tv_nsec != 0;
+    }
+
+    /// Return true if hardware timestamp present
+    bool hasHardware() const noexcept
+    {
+        return hardware.tv_sec != 0 || hardware.tv_nsec != 0;
+    }
+};
+
+/// Extract receive timestamps from control messages of received message
+inline ReceiveTimestamps receiveTimestamps(const msghdr& header) noexcept
+{
+    ReceiveTimestamps result;
+    for (auto cmsg: ControlMessages{header}) {
+        if (cmsg.level() != SOL_SOCKET) {
+            continue;
+        }
+        switch (cmsg.type()) {
+            case SCM_TIMESTAMPNS:
+                cmsg.get(result.software);
+                break;
+            case SCM_TIMESTAMP: {
+                timeval value;
+                if (cmsg.get(value)) {
+                    result.software = {value.tv_sec, value.tv_usec * 1000};
+                }
+                break;
+            }
+            case SCM_TIMESTAMPING: {
+                scm_timestamping value;
+                if (cmsg.get(value)) {
+                    // ts[1] is deprecated legacy hardware timestamp
+                    if (value.ts[0].tv_sec != 0 || value.ts[0].tv_nsec != 0) {
+                        result.software = value.ts[0];
+                    }
+                    result.hardware = value.ts[2];
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return result;
+}
+
+/// Control buffer big enough for receive timestamps
+union TimestampsControlBuffer
+{
+    char data[CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(scm_timestamping))];
+    cmsghdr align;
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_ControlMessages_181026195318 */
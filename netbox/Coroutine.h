@@ -0,0 +1,408 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Coroutine_181026204521
+#define KSERGEY_Coroutine_181026204521
+
+// Coroutines need C++20, the header is empty otherwise
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <sys/socket.h>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <new>
+#include <utility>
+
+#include <netbox/compiler.h>
+#include <netbox/MessageBatch.h>
+#include <netbox/Reactor.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+
+namespace netbox::coro {
+
+/// Thread local pool of coroutine frames
+/// Released frames are kept in free lists by size class and reused,
+/// so steady state coroutine creation doesn't allocate.
+class FrameAllocator
+{
+private:
+    static constexpr std::size_t Granularity = 64;
+    static constexpr std::size_t MaxSize = 4096;
+
+    struct Node
+    {
+        Node* next;
+    };
+
+    Node* free_[MaxSize / Granularity] = {};
+
+public:
+    FrameAllocator() = default;
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    /// Destructor, releases pooled frames
+    ~FrameAllocator() noexcept
+    {
+        for (Node* node: free_) {
+            while (node) {
+                ::operator delete(std::exchange(node, node->next));
+            }
+        }
+    }
+
+    /// Return allocator of the calling thread
+    static FrameAllocator& instance() noexcept
+    {
+        thread_local FrameAllocator allocator;
+        return allocator;
+    }
+
+    /// Allocate frame of `size` bytes
+    /// @throw std::bad_alloc if allocation failed
+    void* allocate(std::size_t size)
+    {
+        if (NETBOX_UNLIKELY(size > MaxSize)) {
+            return ::operator new(size);
+        }
+        const std::size_t index = (size - 1) / Granularity;
+        if (Node* node = free_[index]; NETBOX_LIKELY(node)) {
+            free_[index] = node->next;
+            return node;
+        }
+        return ::operator new((index + 1) * Granularity);
+    }
+
+    /// Release frame allocated with `allocate(size)`
+    void deallocate(void* data, std::size_t size) noexcept
+    {
+        if (NETBOX_UNLIKELY(size > MaxSize)) {
+            ::operator delete(data);
+            return;
+        }
+        const std::size_t index = (size - 1) / Granularity;
+        free_[index] = new (data) Node{free_[index]};
+    }
+};
+
+/// Detached coroutine started immediately, its frame is released on completion
+/// Exception escaping the coroutine terminates the program.
+/// @warning The coroutine should not be left suspended when the reactor destroyed
+class Task
+{
+public:
+    struct promise_type
+    {
+        Task get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {}
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        static void* operator new(std::size_t size)
+        {
+            return FrameAllocator::instance().allocate(size);
+        }
+
+        static void operator delete(void* data, std::size_t size) noexcept
+        {
+            FrameAllocator::instance().deallocate(data, size);
+        }
+    };
+};
+
+namespace details {
+
+/// Coroutine suspended until socket ready
+struct Waiter
+{
+    /// Retry operation, return false if socket still not ready
+    bool (*retry)(Waiter*);
+    std::coroutine_handle<> handle;
+};
+
+/// Sockets awaited by coroutines of the calling thread
+/// Socket is registered in reactor on the first wait and stays registered
+/// as one-shot, each wait only re-arms it. One coroutine may wait for reading
+/// while another waits for writing the same socket. Registration of closed
+/// socket is dropped by the kernel and renewed when the descriptor reused.
+/// @warning Socket should be awaited through one reactor at a time
+class SocketWaiters
+{
+private:
+    struct Entry
+    {
+        // Id of reactor the socket registered in, 0 - not registered
+        std::uint64_t reactorId{0};
+        Reactor* reactor{nullptr};
+        Reactor::Handle registration;
+        Waiter* reader{nullptr};
+        Waiter* writer{nullptr};
+
+        std::uint32_t interest() const noexcept
+        {
+            return (reader ? std::uint32_t(Reactor::Readable) : 0u) | (writer ? std::uint32_t(Reactor::Writable) : 0u);
+        }
+
+        /// Reactor handler, completes at most one waiter per call
+        void operator()(std::uint32_t ready)
+        {
+            // Errors are reported to both directions
+            constexpr std::uint32_t Failure = Reactor::HangUp | Reactor::Error;
+            Waiter* waiter = nullptr;
+            if (reader && (ready & (Reactor::Readable | Failure)) && reader->retry(reader)) {
+                waiter = std::exchange(reader, nullptr);
+            } else if (writer && (ready & (Reactor::Writable | Failure)) && writer->retry(writer)) {
+                waiter = std::exchange(writer, nullptr);
+            }
+
+            // The kernel disarmed the socket
+            if (const std::uint32_t events = interest(); events != 0) {
+                reactor->modify(registration, events, Reactor::Trigger::Once);
+            }
+            if (waiter) {
+                waiter->handle.resume();
+            }
+        }
+    };
+
+    // Indexed by descriptor, deque keeps entries in place while growing
+    std::deque< Entry > entries_;
+
+public:
+    SocketWaiters() = default;
+    SocketWaiters(const SocketWaiters&) = delete;
+    SocketWaiters& operator=(const SocketWaiters&) = delete;
+
+    /// Return registry of the calling thread
+    static SocketWaiters& instance() noexcept
+    {
+        thread_local SocketWaiters waiters;
+        return waiters;
+    }
+
+    /// Resume `waiter` once `socket` is ready for `events` and the retried operation completed
+    /// @param[in] events is `Reactor::Readable` or `Reactor::Writable`
+    /// @return False if the direction already awaited (errno is `EBUSY`)
+    /// @throw SocketError if the socket couldn't be registered
+    bool wait(Reactor& reactor, Socket& socket, std::uint32_t events, Waiter& waiter)
+    {
+        const auto fd = std::size_t(socket.native());
+        if (NETBOX_UNLIKELY(fd >= entries_.size())) {
+            entries_.resize(fd + 1);
+        }
+        Entry& entry = entries_[fd];
+
+        if (NETBOX_UNLIKELY(entry.reactorId != reactor.id())) {
+            if (entry.reader || entry.writer) {
+                // Awaited through another reactor
+                errno = EBUSY;
+                return false;
+            }
+            // Registration in destroyed (or another) reactor is forgotten
+            entry = Entry{};
+        }
+
+        Waiter*& slot = (events & Reactor::Readable) ? entry.reader : entry.writer;
+        if (NETBOX_UNLIKELY(slot)) {
+            errno = EBUSY;
+            return false;
+        }
+        slot = &waiter;
+
+        if (NETBOX_LIKELY(entry.reactorId != 0)) {
+            if (NETBOX_LIKELY(reactor.modify(entry.registration, entry.interest(), Reactor::Trigger::Once))) {
+                return true;
+            }
+            // Socket closed and descriptor reused, the kernel dropped registration
+            reactor.remove(entry.registration);
+            entry.reactorId = 0;
+        }
+
+        try {
+            entry.registration = reactor.add(socket, entry.interest(), Reactor::Trigger::Once, entry);
+        } catch (...) {
+            slot = nullptr;
+            throw;
+        }
+        entry.reactorId = reactor.id();
+        entry.reactor = &reactor;
+        return true;
+    }
+};
+
+/// Awaitable retrying non-blocking operation on socket readiness
+/// One coroutine may wait for reading and one for writing the same socket,
+/// another waiter of the same direction gets `EBUSY` error result.
+/// @tparam Operation is callable returning `Result`, the result derived from `ErrorCode`,
+///     `isTryAgain()` result makes the awaiter wait for readiness and retry
+template< class Operation, class Result >
+class IoAwaiter
+    : Waiter
+{
+private:
+    Reactor* reactor_;
+    Socket* socket_;
+    std::uint32_t events_;
+    Operation operation_;
+    Result result_;
+
+public:
+    IoAwaiter(Reactor& reactor, Socket& socket, std::uint32_t events, Operation operation)
+        : Waiter{&IoAwaiter::tryComplete, {}}
+        , reactor_{&reactor}
+        , socket_{&socket}
+        , events_{events}
+        , operation_{std::move(operation)}
+    {}
+
+    /// Try operation first, suspend only if socket not ready
+    bool await_ready()
+    {
+        result_ = operation_();
+        return !result_.isTryAgain();
+    }
+
+    /// Wait for socket readiness
+    /// @return False if the coroutine isn't suspended, the result holds the error
+    /// @throw SocketError if the socket couldn't be registered
+    bool await_suspend(std::coroutine_handle<> coroutine)
+    {
+        handle = coroutine;
+        if (NETBOX_UNLIKELY(!SocketWaiters::instance().wait(*reactor_, *socket_, events_, *this))) {
+            result_ = Result(BadFd);
+            return false;
+        }
+        return true;
+    }
+
+    Result await_resume() noexcept
+    {
+        return std::move(result_);
+    }
+
+private:
+    static bool tryComplete(Waiter* waiter)
+    {
+        auto* self = static_cast< IoAwaiter* >(waiter);
+        self->result_ = self->operation_();
+        return !self->result_.isTryAgain();
+    }
+};
+
+template< class Result, class Operation >
+IoAwaiter< Operation, Result > makeAwaiter(Reactor& reactor, Socket& socket, std::uint32_t events, Operation operation)
+{
+    return {reactor, socket, events, std::move(operation)};
+}
+
+} /* namespace details */
+
+/// Establish connection
+/// @pre `socket` is non-blocking
+/// @return Awaitable of `OpResult`
+inline auto connect(Reactor& reactor, Socket& socket, const sockaddr* addr, socklen_t addrlen)
+{
+    // First call starts connect, later calls take its result
+    return details::makeAwaiter< OpResult >(reactor, socket, Reactor::Writable,
+            [&socket, addr, addrlen, started = false]() mutable -> OpResult {
+        if (!started) {
+            started = true;
+            const int result = ::connect(socket.native(), addr, addrlen);
+            if (result != 0 && errno == EINPROGRESS) {
+                errno = EAGAIN;
+            }
+            return result;
+        }
+        int error = 0;
+        socklen_t size = sizeof(error);
+        if (::getsockopt(socket.native(), SOL_SOCKET, SO_ERROR, &error, &size) != 0) {
+            return -1;
+        }
+        errno = error;
+        return error == 0 ? 0 : -1;
+    });
+}
+
+/// @overload
+template< class Endpoint >
+inline auto connect(Reactor& reactor, Socket& socket, const Endpoint& endpoint)
+{
+    return connect(reactor, socket, endpoint.data(), endpoint.size());
+}
+
+/// Accept incoming connection
+/// @pre `socket` is non-blocking
+/// @return Awaitable of `SocketResult`
+inline auto accept(Reactor& reactor, Socket& socket, sockaddr* addr = nullptr, socklen_t* addrlen = nullptr)
+{
+    return details::makeAwaiter< SocketResult >(reactor, socket, Reactor::Readable, [&socket, addr, addrlen] {
+        return SocketResult{::accept4(socket.native(), addr, addrlen, SOCK_CLOEXEC)};
+    });
+}
+
+/// Recv data from socket
+/// @return Awaitable of `TransmitResult`
+inline auto recv(Reactor& reactor, Socket& socket, void* buf, std::size_t len)
+{
+    return details::makeAwaiter< TransmitResult >(reactor, socket, Reactor::Readable, [&socket, buf, len] {
+        return TransmitResult{::recv(socket.native(), buf, len, MSG_DONTWAIT)};
+    });
+}
+
+/// Recv datagram from socket
+/// @return Awaitable of `TransmitResult`
+inline auto recvfrom(Reactor& reactor, Socket& socket, void* buf, std::size_t len, sockaddr* src_addr, socklen_t* addrlen)
+{
+    return details::makeAwaiter< TransmitResult >(reactor, socket, Reactor::Readable, [&socket, buf, len, src_addr, addrlen] {
+        return TransmitResult{::recvfrom(socket.native(), buf, len, MSG_DONTWAIT, src_addr, addrlen)};
+    });
+}
+
+/// Send data into socket
+/// @return Awaitable of `TransmitResult`
+inline auto send(Reactor& reactor, Socket& socket, const void* buf, std::size_t len)
+{
+    return details::makeAwaiter< TransmitResult >(reactor, socket, Reactor::Writable, [&socket, buf, len] {
+        return TransmitResult{::send(socket.native(), buf, len, MSG_DONTWAIT | MSG_NOSIGNAL)};
+    });
+}
+
+/// Receive batch of datagrams
+/// @see recvBatch()
+/// @return Awaitable of `TransmitResult` (number of messages received)
+inline auto recvBatch(Reactor& reactor, Socket& socket, MessageBatch& batch)
+{
+    return details::makeAwaiter< TransmitResult >(reactor, socket, Reactor::Readable, [&socket, &batch] {
+        return netbox::recvBatch(socket, batch, MSG_DONTWAIT);
+    });
+}
+
+} /* namespace netbox::coro */
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* KSERGEY_Coroutine_181026204521 */
@@ -0,0 +1,476 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_IoUring_181026203012
+#define KSERGEY_IoUring_181026203012
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <netbox/buffer.h>
+#include <netbox/compiler.h>
+#include <netbox/details/MappedRegion.h>
+#include <netbox/exception.h>
+#include <netbox/Socket.h>
+
+namespace netbox {
+
+/// io_uring completion
+class IoUringCompletion
+{
+private:
+    const io_uring_cqe* cqe_;
+
+public:
+    /// Construct from native completion
+    constexpr explicit IoUringCompletion(const io_uring_cqe* cqe) noexcept
+        : cqe_{cqe}
+    {}
+
+    /// Return user data of submitted operation
+    std::uint64_t userData() const noexcept
+    {
+        return cqe_->user_data;
+    }
+
+    /// Return operation result (bytes transferred, accepted descriptor, ...)
+    /// or negative errno on error
+    int result() const noexcept
+    {
+        return cqe_->res;
+    }
+
+    /// Return completion flags (`IORING_CQE_F_*`)
+    std::uint32_t flags() const noexcept
+    {
+        return cqe_->flags;
+    }
+
+    /// Return true if multishot operation stays armed and will complete again
+    bool more() const noexcept
+    {
+        return cqe_->flags & IORING_CQE_F_MORE;
+    }
+
+    /// Return true if completion consumed provided buffer
+    bool hasBuffer() const noexcept
+    {
+        return cqe_->flags & IORING_CQE_F_BUFFER;
+    }
+
+    /// Return identifier of provided buffer
+    /// @pre `hasBuffer()`
+    std::uint16_t bufferId() const noexcept
+    {
+        return cqe_->flags >> IORING_CQE_BUFFER_SHIFT;
+    }
+};
+
+/// io_uring instance (submission and completion queues)
+/// Built on raw syscalls, no liburing dependency. Operations are queued with
+/// `accept()`, `recv()`, `send()`, ... and passed to the kernel in one
+/// `submit()` call, completions are consumed in batches with `complete()`.
+/// @warning Not thread safe
+class IoUring
+{
+private:
+    Socket ring_;
+    io_uring_params params_{};
+
+    details::MappedRegion sqMap_;
+    // Not mapped if kernel supports single mapping for both queues
+    details::MappedRegion cqMap_;
+    details::MappedRegion sqeMap_;
+    io_uring_sqe* sqes_{nullptr};
+
+    std::uint32_t* sqHead_{nullptr};
+    std::uint32_t* sqTail_{nullptr};
+    // Kernel sets IORING_SQ_CQ_OVERFLOW when completions didn't fit completion queue
+    std::uint32_t* sqFlags_{nullptr};
+    std::uint32_t sqMask_{0};
+    // Local tail, published on submit
+    std::uint32_t sqLocalTail_{0};
+    std::uint32_t sqSubmitted_{0};
+
+    std::uint32_t* cqHead_{nullptr};
+    std::uint32_t* cqTail_{nullptr};
+    std::uint32_t cqMask_{0};
+    io_uring_cqe* cqes_{nullptr};
+
+public:
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /// Create io_uring instance and map its queues
+    /// @param[in] entries is submission queue size (completion queue is twice bigger)
+    /// @param[in] flags is `IORING_SETUP_*` flags
+    /// @throw SocketError on error
+    explicit IoUring(unsigned entries = 256, unsigned flags = 0)
+    {
+        params_.flags = flags;
+        ring_ = Socket{int(::syscall(__NR_io_uring_setup, entries, &params_))};
+        if (!ring_) {
+            throwEx< SocketError >("io_uring_setup", errno);
+        }
+
+        std::size_t sqMapSize = params_.sq_off.array + params_.sq_entries * sizeof(std::uint32_t);
+        const std::size_t cqMapSize = params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = params_.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) {
+            sqMapSize = std::max(sqMapSize, cqMapSize);
+        }
+
+        sqMap_ = map(sqMapSize, IORING_OFF_SQ_RING);
+        if (!singleMap) {
+            cqMap_ = map(cqMapSize, IORING_OFF_CQ_RING);
+        }
+        sqeMap_ = map(params_.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES);
+        sqes_ = reinterpret_cast< io_uring_sqe* >(sqeMap_.data());
+
+        char* sq = sqMap_.data();
+        sqHead_ = reinterpret_cast< std::uint32_t* >(sq + params_.sq_off.head);
+        sqTail_ = reinterpret_cast< std::uint32_t* >(sq + params_.sq_off.tail);
+        sqFlags_ = reinterpret_cast< std::uint32_t* >(sq + params_.sq_off.flags);
+        sqMask_ = *reinterpret_cast< std::uint32_t* >(sq + params_.sq_off.ring_mask);
+        sqLocalTail_ = sqSubmitted_ = *sqTail_;
+
+        // Identity mapping, SQE index is the array index
+        auto* array = reinterpret_cast< std::uint32_t* >(sq + params_.sq_off.array);
+        for (std::uint32_t i = 0; i < params_.sq_entries; ++i) {
+            array[i] = i;
+        }
+
+        char* cq = singleMap ? sqMap_.data() : cqMap_.data();
+        cqHead_ = reinterpret_cast< std::uint32_t* >(cq + params_.cq_off.head);
+        cqTail_ = reinterpret_cast< std::uint32_t* >(cq + params_.cq_off.tail);
+        cqMask_ = *reinterpret_cast< std::uint32_t* >(cq + params_.cq_off.ring_mask);
+        cqes_ = reinterpret_cast< io_uring_cqe* >(cq + params_.cq_off.cqes);
+    }
+
+    /// Destructor, unmaps queues, pending operations are cancelled by kernel
+    ~IoUring() noexcept = default;
+
+    /// Return io_uring descriptor
+    int native() noexcept
+    {
+        return ring_.native();
+    }
+
+    /// Return submission queue entry to fill, submits queued entries if queue full
+    /// @return Cleared entry or `nullptr` if queue full
+    io_uring_sqe* acquire() noexcept
+    {
+        if (NETBOX_UNLIKELY(sqLocalTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= params_.sq_entries)) {
+            submit();
+            if (sqLocalTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= params_.sq_entries) {
+                return nullptr;
+            }
+        }
+        io_uring_sqe* sqe = &sqes_[sqLocalTail_ & sqMask_];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        sqLocalTail_ += 1;
+        return sqe;
+    }
+
+    /// Queue multishot accept, completes with accepted descriptor per connection
+    /// @return False if submission queue full
+    bool acceptMultishot(Socket& socket, std::uint64_t userData, int flags = SOCK_CLOEXEC) noexcept
+    {
+        io_uring_sqe* sqe = prepare(IORING_OP_ACCEPT, socket, userData);
+        if (NETBOX_UNLIKELY(!sqe)) {
+            return false;
+        }
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = flags;
+        return true;
+    }
+
+    /// Queue multishot receive into buffers of provided buffer ring
+    /// Completes per received chunk (datagram) with `hasBuffer()` completion
+    /// @param[in] group is provided buffer ring group
+    /// @return False if submission queue full
+    bool recvMultishot(Socket& socket, std::uint16_t group, std::uint64_t userData) noexcept
+    {
+        io_uring_sqe* sqe = prepare(IORING_OP_RECV, socket, userData);
+        if (NETBOX_UNLIKELY(!sqe)) {
+            return false;
+        }
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = group;
+        return true;
+    }
+
+    /// Queue receive into buffer
+    /// @return False if submission queue full
+    bool recv(Socket& socket, void* buf, std::size_t len, std::uint64_t userData, int flags = 0) noexcept
+    {
+        io_uring_sqe* sqe = prepare(IORING_OP_RECV, socket, userData);
+        if (NETBOX_UNLIKELY(!sqe)) {
+            return false;
+        }
+        sqe->addr = reinterpret_cast< std::uintptr_t >(buf);
+        sqe->len = len;
+        sqe->msg_flags = flags;
+        return true;
+    }
+
+    /// Queue send, the buffer should stay valid until completion
+    /// @return False if submission queue full
+    bool send(Socket& socket, const void* buf, std::size_t len, std::uint64_t userData, int flags = 0) noexcept
+    {
+        io_uring_sqe* sqe = prepare(IORING_OP_SEND, socket, userData);
+        if (NETBOX_UNLIKELY(!sqe)) {
+            return false;
+        }
+        sqe->addr = reinterpret_cast< std::uintptr_t >(buf);
+        sqe->len = len;
+        sqe->msg_flags = flags;
+        return true;
+    }
+
+    /// Queue cancellation of operations with `userData`
+    /// @return False if submission queue full
+    bool cancel(std::uint64_t target, std::uint64_t userData) noexcept
+    {
+        io_uring_sqe* sqe = acquire();
+        if (NETBOX_UNLIKELY(!sqe)) {
+            return false;
+        }
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = target;
+        sqe->cancel_flags = IORING_ASYNC_CANCEL_ALL;
+        sqe->user_data = userData;
+        return true;
+    }
+
+    /// Return number of queued not submitted entries
+    std::uint32_t queued() const noexcept
+    {
+        return sqLocalTail_ - sqSubmitted_;
+    }
+
+    /// Submit queued entries and optionally wait for completions, in one syscall
+    /// @param[in] waitNr is number of completions to wait for
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return Number of entries submitted or -1 on error (see errno)
+    int submit(unsigned waitNr = 0, int timeout = -1) noexcept
+    {
+        __atomic_store_n(sqTail_, sqLocalTail_, __ATOMIC_RELEASE);
+        const unsigned count = sqLocalTail_ - sqSubmitted_;
+
+        // Overflowed completions are moved to completion queue on GETEVENTS only
+        unsigned flags = waitNr > 0 || overflow() ? IORING_ENTER_GETEVENTS : 0;
+        __kernel_timespec ts{timeout / 1000, (timeout % 1000) * 1000000ll};
+        io_uring_getevents_arg arg{};
+        void* argp = nullptr;
+        std::size_t argSize = 0;
+        if (waitNr > 0 && timeout >= 0) {
+            arg.ts = reinterpret_cast< std::uintptr_t >(&ts);
+            flags |= IORING_ENTER_EXT_ARG;
+            argp = &arg;
+            argSize = sizeof(arg);
+        }
+        if (count == 0 && flags == 0) {
+            return 0;
+        }
+
+        const int result = ::syscall(__NR_io_uring_enter, ring_.native(), count, waitNr, flags, argp, argSize);
+        if (NETBOX_UNLIKELY(result < 0)) {
+            // Nothing submitted and no completions before timeout or signal
+            return errno == ETIME || errno == EINTR ? 0 : -1;
+        }
+        sqSubmitted_ += result;
+        return result;
+    }
+
+    /// Consume available completions
+    /// Completions the kernel kept aside on completion queue overflow are
+    /// flushed into the queue and consumed too.
+    /// @param[in] handler is callable `void(const IoUringCompletion&)`
+    /// @return Number of completions consumed
+    template< class Handler >
+    std::size_t complete(Handler&& handler)
+    {
+        std::size_t result = 0;
+        while (true) {
+            std::uint32_t head = *cqHead_;
+            const std::uint32_t tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+            result += tail - head;
+            for (; head != tail; ++head) {
+                handler(IoUringCompletion{&cqes_[head & cqMask_]});
+                // Handler may submit, free the slot as soon as possible
+                __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+            }
+            if (NETBOX_LIKELY(!overflow())) {
+                break;
+            }
+            if (::syscall(__NR_io_uring_enter, ring_.native(), 0, 0, IORING_ENTER_GETEVENTS, nullptr, 0) < 0) {
+                break;
+            }
+        }
+        return result;
+    }
+
+    /// Return true if completion queue overflowed and some completions are
+    /// waiting in the kernel, they are flushed by `submit()` and `complete()`
+    bool overflow() const noexcept
+    {
+        return __atomic_load_n(sqFlags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW;
+    }
+
+private:
+    details::MappedRegion map(std::size_t size, off_t offset)
+    {
+        return {size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_.native(), offset};
+    }
+
+    io_uring_sqe* prepare(std::uint8_t opcode, Socket& socket, std::uint64_t userData) noexcept
+    {
+        io_uring_sqe* sqe = acquire();
+        if (NETBOX_LIKELY(sqe)) {
+            sqe->opcode = opcode;
+            sqe->fd = socket.native();
+            sqe->user_data = userData;
+        }
+        return sqe;
+    }
+};
+
+/// Kernel provided buffer ring (`IORING_REGISTER_PBUF_RING`)
+/// The kernel picks a buffer for each multishot receive completion,
+/// buffers should be given back with `recycle()` after use.
+class IoUringBufferRing
+{
+private:
+    IoUring* ring_;
+    // Ring entries, the ring tail overlays `resv` of the first entry
+    // (`io_uring_buf_ring::bufs` is misplaced when the header compiled as C++)
+    io_uring_buf* buffers_{nullptr};
+    std::uint16_t* ringTail_{nullptr};
+    char* data_{nullptr};
+    std::size_t mapSize_{0};
+    std::uint32_t count_{0};
+    std::uint32_t bufferSize_{0};
+    std::uint16_t group_{0};
+    std::uint16_t tail_{0};
+
+public:
+    IoUringBufferRing(const IoUringBufferRing&) = delete;
+    IoUringBufferRing& operator=(const IoUringBufferRing&) = delete;
+
+    /// Allocate buffers and register the ring
+    /// @param[in] ring is io_uring instance, should outlive the buffer ring
+    /// @param[in] group is buffer group identifier used by receive operations
+    /// @param[in] count is number of buffers (power of two, up to 32768)
+    /// @param[in] bufferSize is size of each buffer
+    /// @throw SocketError on error
+    IoUringBufferRing(IoUring& ring, std::uint16_t group, std::uint32_t count, std::uint32_t bufferSize)
+        : ring_{&ring}
+        , count_{count}
+        , bufferSize_{bufferSize}
+        , group_{group}
+    {
+        if (count_ == 0 || count_ > 32768 || (count_ & (count_ - 1)) != 0) {
+            throwEx< SocketError >("IoUringBufferRing count", EINVAL);
+        }
+
+        // Ring entries followed by buffers, ring should be page aligned
+        const std::size_t ringSize = count_ * sizeof(io_uring_buf);
+        mapSize_ = ringSize + std::size_t(count_) * bufferSize_;
+        void* map = ::mmap(nullptr, mapSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            throwEx< SocketError >("mmap", errno);
+        }
+        buffers_ = static_cast< io_uring_buf* >(map);
+        ringTail_ = &buffers_[0].resv;
+        data_ = static_cast< char* >(map) + ringSize;
+
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast< std::uintptr_t >(buffers_);
+        reg.ring_entries = count_;
+        reg.bgid = group_;
+        if (::syscall(__NR_io_uring_register, ring_->native(), IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+            const int error = errno;
+            ::munmap(map, mapSize_);
+            throwEx< SocketError >("io_uring_register(IORING_REGISTER_PBUF_RING)", error);
+        }
+
+        for (std::uint32_t i = 0; i < count_; ++i) {
+            add(i);
+        }
+        publish();
+    }
+
+    /// Destructor, unregisters the ring and releases buffers
+    ~IoUringBufferRing() noexcept
+    {
+        io_uring_buf_reg reg{};
+        reg.bgid = group_;
+        ::syscall(__NR_io_uring_register, ring_->native(), IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        ::munmap(buffers_, mapSize_);
+    }
+
+    /// Return buffer group identifier
+    std::uint16_t group() const noexcept
+    {
+        return group_;
+    }
+
+    /// Return size of each buffer
+    std::size_t bufferSize() const noexcept
+    {
+        return bufferSize_;
+    }
+
+    /// Return received data of completion
+    /// @pre `completion.hasBuffer()`
+    ConstBuffer buffer(const IoUringCompletion& completion) const noexcept
+    {
+        return {data_ + std::size_t(completion.bufferId()) * bufferSize_, std::size_t(std::max(completion.result(), 0))};
+    }
+
+    /// Give buffer of completion back to the kernel
+    void recycle(const IoUringCompletion& completion) noexcept
+    {
+        recycle(completion.bufferId());
+    }
+
+    /// Give buffers back to the kernel
+    /// @overload
+    void recycle(std::uint16_t bufferId) noexcept
+    {
+        add(bufferId);
+        publish();
+    }
+
+private:
+    void add(std::uint16_t bufferId) noexcept
+    {
+        io_uring_buf& buffer = buffers_[tail_ & (count_ - 1)];
+        buffer.addr = reinterpret_cast< std::uintptr_t >(data_ + std::size_t(bufferId) * bufferSize_);
+        buffer.len = bufferSize_;
+        buffer.bid = bufferId;
+        tail_ += 1;
+    }
+
+    void publish() noexcept
+    {
+        __atomic_store_n(ringTail_, tail_, __ATOMIC_RELEASE);
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_IoUring_181026203012 */
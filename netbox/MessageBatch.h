@@ -0,0 +1,281 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_MessageBatch_181026194107
+#define KSERGEY_MessageBatch_181026194107
+
+#include <sys/socket.h>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+#include <netbox/compiler.h>
+#include <netbox/ControlMessages.h>
+#include <netbox/details/concepts.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+#include <netbox/utils/Arena.h>
+
+namespace netbox {
+
+/// Preallocated storage for batched datagram receive and send (`recvmmsg`/`sendmmsg`)
+/// Message headers, iovecs, addresses, control buffers and payload buffers
+/// of all messages live in a single arena and are set up once.
+class MessageBatch
+{
+private:
+    utils::Arena arena_;
+    mmsghdr* headers_{nullptr};
+    sockaddr_storage* addresses_{nullptr};
+    char* payload_{nullptr};
+
+    std::size_t capacity_{0};
+    std::size_t messageSize_{0};
+    std::size_t controlSize_{0};
+
+    // Number of messages in batch
+    std::size_t size_{0};
+    // Number of leading headers modified since the last reset for receive
+    std::size_t dirty_{0};
+
+public:
+    MessageBatch(const MessageBatch&) = delete;
+    MessageBatch& operator=(const MessageBatch&) = delete;
+    MessageBatch(MessageBatch&&) = default;
+    MessageBatch& operator=(MessageBatch&&) = default;
+
+    /// Construct batch
+    /// @param[in] capacity is maximum number of messages
+    /// @param[in] messageSize is size of message buffer
+    /// @param[in] controlSize is size of control (ancillary data) buffer per message
+    /// @throw std::bad_alloc if allocation failed
+    explicit MessageBatch(std::size_t capacity, std::size_t messageSize = 2048, std::size_t controlSize = 128)
+        : capacity_{capacity}
+        , messageSize_{messageSize}
+        , controlSize_{CMSG_ALIGN(controlSize)}
+    {
+        const std::size_t headersSize = capacity_ * sizeof(mmsghdr);
+        const std::size_t iovecsSize = capacity_ * sizeof(iovec);
+        const std::size_t addressesSize = capacity_ * sizeof(sockaddr_storage);
+        const std::size_t controlsSize = capacity_ * controlSize_;
+
+        // Addresses are the most aligned, placed first
+        char* data = arena_.reserve(addressesSize + headersSize + iovecsSize + controlsSize + capacity_ * messageSize_);
+        addresses_ = reinterpret_cast< sockaddr_storage* >(data);
+        headers_ = reinterpret_cast< mmsghdr* >(data + addressesSize);
+        auto* iovecs = reinterpret_cast< iovec* >(data + addressesSize + headersSize);
+        char* controls = data + addressesSize + headersSize + iovecsSize;
+        payload_ = controls + controlsSize;
+
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            iovecs[i].iov_base = payload_ + i * messageSize_;
+            iovecs[i].iov_len = messageSize_;
+
+            msghdr& header = headers_[i].msg_hdr;
+            header.msg_name = &addresses_[i];
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+            header.msg_control = controlSize_ > 0 ? controls + i * controlSize_ : nullptr;
+            header.msg_controllen = controlSize_;
+            header.msg_flags = 0;
+            headers_[i].msg_len = 0;
+        }
+    }
+
+    /// Return maximum number of messages
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /// Return size of message buffer
+    std::size_t messageSize() const noexcept
+    {
+        return messageSize_;
+    }
+
+    /// Return number of messages in batch
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return true if batch has no messages
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /// Return true if no room for another message
+    bool full() const noexcept
+    {
+        return size_ == capacity_;
+    }
+
+    /// Remove all messages
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    /// Return message buffer
+    void* data(std::size_t index) noexcept
+    {
+        return headers_[index].msg_hdr.msg_iov->iov_base;
+    }
+
+    /// @overload
+    const void* data(std::size_t index) const noexcept
+    {
+        return headers_[index].msg_hdr.msg_iov->iov_base;
+    }
+
+    /// Return number of bytes received into message buffer or number of bytes sent
+    std::size_t length(std::size_t index) const noexcept
+    {
+        return headers_[index].msg_len;
+    }
+
+    /// Return true if received message didn't fit into buffer
+    bool truncated(std::size_t index) const noexcept
+    {
+        return headers_[index].msg_hdr.msg_flags & MSG_TRUNC;
+    }
+
+    /// Return message address (source of received or destination of queued message)
+    const sockaddr* address(std::size_t index) const noexcept
+    {
+        return reinterpret_cast< const sockaddr* >(&addresses_[index]);
+    }
+
+    /// Return size of message address
+    socklen_t addressLength(std::size_t index) const noexcept
+    {
+        return headers_[index].msg_hdr.msg_namelen;
+    }
+
+    /// Return message address as endpoint
+    /// @throw AddressError if address family doesn't match endpoint
+    template< class Endpoint >
+    Endpoint endpoint(std::size_t index) const
+    {
+        static_assert( details::HasMemberResize< Endpoint >(),
+               "Endpoint not meet requirements" );
+
+        Endpoint endpoint;
+        std::memcpy(endpoint.data(), address(index), std::min(endpoint.size(), addressLength(index)));
+        endpoint.resize(addressLength(index));
+        return endpoint;
+    }
+
+    /// Return control messages of received message
+    ControlMessages controlMessages(std::size_t index) const noexcept
+    {
+        return ControlMessages{headers_[index].msg_hdr};
+    }
+
+    /// Return receive timestamps of received message
+    /// @see receiveTimestamps()
+    ReceiveTimestamps timestamps(std::size_t index) const noexcept
+    {
+        return receiveTimestamps(headers_[index].msg_hdr);
+    }
+
+    /// Return software receive timestamp (`SO_TIMESTAMPNS` should be enabled on socket)
+    /// @return Timestamp or zero timestamp if message has no one
+    timespec timestamp(std::size_t index) const noexcept
+    {
+        return timestamps(index).software;
+    }
+
+    /// Append message to send
+    /// @param[in] data is message data
+    /// @param[in] size is message size
+    /// @param[in] address is destination address, `nullptr` for connected socket
+    /// @param[in] addressLength is size of destination address
+    /// @return False if batch full or message bigger than `messageSize()`
+    bool push(const void* data, std::size_t size, const sockaddr* address = nullptr, socklen_t addressLength = 0) noexcept
+    {
+        if (NETBOX_UNLIKELY(full() || size > messageSize_ || addressLength > sizeof(sockaddr_storage))) {
+            return false;
+        }
+        msghdr& header = headers_[size_].msg_hdr;
+        std::memcpy(header.msg_iov->iov_base, data, size);
+        header.msg_iov->iov_len = size;
+        if (address) {
+            std::memcpy(&addresses_[size_], address, addressLength);
+        }
+        header.msg_namelen = addressLength;
+        header.msg_controllen = 0;
+        headers_[size_].msg_len = 0;
+        size_ += 1;
+        dirty_ = std::max(dirty_, size_);
+        return true;
+    }
+
+    /// @overload
+    template< class Endpoint >
+    bool push(const void* data, std::size_t size, const Endpoint& endpoint) noexcept
+    {
+        return push(data, size, endpoint.data(), endpoint.size());
+    }
+
+    /// Return message headers
+    mmsghdr* headers() noexcept
+    {
+        return headers_;
+    }
+
+    /// Reset headers modified by receive or push and clear the batch
+    /// @return Message headers ready to receive into
+    mmsghdr* prepareReceive() noexcept
+    {
+        for (std::size_t i = 0; i < dirty_; ++i) {
+            msghdr& header = headers_[i].msg_hdr;
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_iov->iov_len = messageSize_;
+            header.msg_controllen = controlSize_;
+        }
+        dirty_ = 0;
+        size_ = 0;
+        return headers_;
+    }
+
+    /// Set number of messages received into headers
+    void commitReceive(std::size_t count) noexcept
+    {
+        size_ = count;
+        dirty_ = count;
+    }
+};
+
+/// Receive up to `batch.capacity()` datagrams, previous batch content is dropped
+/// @param[in] socket is socket to receive from
+/// @param[in] batch is batch to receive into
+/// @param[in] flags is `recvmmsg()` flags (`MSG_DONTWAIT`, `MSG_WAITFORONE`, ...)
+/// @return Number of messages received
+NETBOX_FORCE_INLINE TransmitResult recvBatch(Socket& socket, MessageBatch& batch, int flags = 0) noexcept
+{
+    TransmitResult result = ::recvmmsg(socket.native(), batch.prepareReceive(), batch.capacity(), flags, nullptr);
+    if (result) {
+        batch.commitReceive(result.bytes());
+    }
+    return result;
+}
+
+/// Send messages of batch starting from `first`
+/// @param[in] socket is socket to send into
+/// @param[in] batch is batch to send
+/// @param[in] first is index of the first message to send
+/// @param[in] flags is `sendmmsg()` flags
+/// @return Number of messages sent, `batch.length(i)` holds bytes sent per message
+NETBOX_FORCE_INLINE TransmitResult sendBatch(Socket& socket, MessageBatch& batch, std::size_t first = 0, int flags = 0) noexcept
+{
+    return ::sendmmsg(socket.native(), batch.headers() + first, batch.size() - first, flags);
+}
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_MessageBatch_181026194107 */
@@ -0,0 +1,316 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_PacketRing_181026180935
+#define KSERGEY_PacketRing_181026180935
+
+#include <net/if.h>
+#include <poll.h>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/details/byte_order.h>
+#include <netbox/details/MappedRegion.h>
+#include <netbox/details/RingGeometry.h>
+#include <netbox/exception.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/Socket.h>
+#include <netbox/socket_options.h>
+
+namespace netbox {
+
+/// PacketRing tuning
+struct PacketRingOptions
+{
+    /// Interface name to capture on, empty - all interfaces
+    std::string interface;
+
+    /// Ethernet protocol to capture (host byte order)
+    std::uint16_t protocol{ETH_P_ALL};
+
+    /// Ring memory size
+    std::size_t ringSize{64 * 1024 * 1024};
+
+    /// Size of ring block (handed to user space at once)
+    std::size_t blockSize{1024 * 1024};
+
+    /// Time after which partially filled block is handed to user space (milliseconds)
+    unsigned blockTimeout{10};
+
+    /// Hardware timestamping flags (`SOF_TIMESTAMPING_*`), 0 - software timestamps
+    int timestamping{0};
+
+    /// Put interface in promiscuous mode
+    bool promiscuous{false};
+};
+
+/// Ring capture counters
+struct PacketRingStatistics
+{
+    /// Packets seen by the ring, dropped ones included
+    std::uint64_t packets{0};
+    /// Packets dropped because the ring was full
+    std::uint64_t drops{0};
+    /// Number of times the ring was full (kernel waited for a free block)
+    std::uint64_t freezes{0};
+};
+
+/// AF_PACKET fanout mode (distribution of packets between group members)
+enum class FanoutMode
+{
+    /// By flow hash, packets of a flow go to the same member
+    Hash = PACKET_FANOUT_HASH,
+    /// By CPU the packet arrived on
+    Cpu = PACKET_FANOUT_CPU,
+    /// By NIC receive queue
+    QueueMapping = PACKET_FANOUT_QM,
+    /// Round-robin
+    RoundRobin = PACKET_FANOUT_LB
+};
+
+/// Zero-copy live capture through TPACKET_V3 AF_PACKET ring
+/// The kernel fills ring blocks with packets and hands a block to user space
+/// when it is full or after `blockTimeout`. Blocks are given back to the
+/// kernel in batches, on the read call following the one consumed them.
+class PacketRing
+{
+private:
+    Socket socket_;
+    details::RingGeometry geometry_;
+    details::MappedRegion ring_;
+
+    // Block being read (or to be read next), counts up
+    std::size_t head_{0};
+    // Oldest block not given back to kernel, counts up
+    std::size_t tail_{0};
+    // Next frame of `head_` block
+    const tpacket3_hdr* frame_{nullptr};
+    std::uint32_t remaining_{0};
+
+    std::vector< pcap::Packet > batch_;
+
+    // Counters accumulated since ring created (the kernel resets them on read)
+    PacketRingStatistics statistics_;
+
+public:
+    PacketRing(const PacketRing&) = delete;
+    PacketRing& operator=(const PacketRing&) = delete;
+
+    /// Create AF_PACKET socket, setup and map the ring
+    /// @param[in] options is ring tuning
+    /// @throw SocketError, SocketOptionError on error
+    explicit PacketRing(const PacketRingOptions& options = {})
+    {
+        const std::uint16_t protocol = details::hostToNetwork16(options.protocol);
+
+        int ifindex = 0;
+        if (!options.interface.empty()) {
+            ifindex = ::if_nametoindex(options.interface.c_str());
+            if (ifindex == 0) {
+                throwEx< SocketError >("if_nametoindex", errno);
+            }
+        }
+
+        // Bind after ring set up, so no packets queued to socket itself
+        socket_ = Socket::create(AF_PACKET, SOCK_RAW, 0);
+
+        if (auto result = setOption(socket_, Options::Packet::Version{TPACKET_V3}); !result) {
+            throwEx< SocketOptionError >("PACKET_VERSION", result);
+        }
+
+        if (options.timestamping != 0) {
+            if (auto result = setOption(socket_, Options::Packet::Timestamp{options.timestamping}); !result) {
+                throwEx< SocketOptionError >("PACKET_TIMESTAMP", result);
+            }
+        }
+
+        geometry_ = details::RingGeometry::make(options.ringSize, options.blockSize,
+                details::RingGeometry::frameSizeFor(TPACKET3_HDRLEN, ETH_FRAME_LEN));
+
+        tpacket_req3 req{};
+        req.tp_block_size = geometry_.blockSize;
+        req.tp_block_nr = geometry_.blockCount;
+        req.tp_frame_size = geometry_.frameSize;
+        req.tp_frame_nr = geometry_.frameCount;
+        req.tp_retire_blk_tov = options.blockTimeout;
+        if (auto result = setOption(socket_, Options::Packet::RxRingV3{req}); !result) {
+            throwEx< SocketOptionError >("PACKET_RX_RING", result);
+        }
+
+        ring_ = details::MappedRegion{geometry_.size(), PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, socket_.native(), 0};
+
+        sockaddr_ll address{};
+        address.sll_family = AF_PACKET;
+        address.sll_protocol = protocol;
+        address.sll_ifindex = ifindex;
+        if (::bind(socket_.native(), reinterpret_cast< const sockaddr* >(&address), sizeof(address)) != 0) {
+            throwEx< SocketError >("bind", errno);
+        }
+
+        if (options.promiscuous && ifindex != 0) {
+            packet_mreq mreq{};
+            mreq.mr_ifindex = ifindex;
+            mreq.mr_type = PACKET_MR_PROMISC;
+            if (auto result = setOption(socket_, Options::Packet::AddMembership{mreq}); !result) {
+                throwEx< SocketOptionError >("PACKET_ADD_MEMBERSHIP", result);
+            }
+        }
+    }
+
+    /// Return ring socket
+    Socket& socket() noexcept
+    {
+        return socket_;
+    }
+
+    /// Return ring layout
+    const details::RingGeometry& geometry() const noexcept
+    {
+        return geometry_;
+    }
+
+    /// Join fanout group, packets are distributed between rings of the group
+    /// The ring should be bound to the same interface and protocol as other group members
+    /// @param[in] id is group identifier
+    /// @param[in] mode is distribution mode
+    /// @param[in] defrag is true to reassemble IP fragments before hashing
+    /// @throw SocketOptionError on error
+    void joinFanout(std::uint16_t id, FanoutMode mode, bool defrag = false)
+    {
+        const int flags = int(mode) | (defrag ? PACKET_FANOUT_FLAG_DEFRAG : 0);
+        if (auto result = setOption(socket_, Options::Packet::Fanout{id | (flags << 16)}); !result) {
+            throwEx< SocketOptionError >("PACKET_FANOUT", result);
+        }
+    }
+
+    /// Return capture counters since the ring created
+    /// @throw SocketOptionError on error
+    /// @warning Not thread safe, should not be called concurrently with itself
+    PacketRingStatistics statistics()
+    {
+        Options::Packet::StatisticsV3 option;
+        if (auto result = getOption(socket_, option); !result) {
+            throwEx< SocketOptionError >("PACKET_STATISTICS", result);
+        }
+        statistics_.packets += option.value().tp_packets;
+        statistics_.drops += option.value().tp_drops;
+        statistics_.freezes += option.value().tp_freeze_q_cnt;
+        return statistics_;
+    }
+
+    /// Read packet if available
+    /// The returned packet points into the ring and will be
+    /// available until next read from the ring
+    /// @return Packet or empty packet if no packets available
+    pcap::Packet readPacket() noexcept
+    {
+        releaseBlocks();
+        return nextPacket();
+    }
+
+    /// Read up to `count` available packets
+    /// Packets point into the ring and will be available until next read from the ring
+    /// @return Number of packets read
+    std::size_t readPackets(pcap::Packet* packets, std::size_t count) noexcept
+    {
+        releaseBlocks();
+
+        std::size_t result = 0;
+        while (result < count) {
+            auto packet = nextPacket();
+            if (NETBOX_UNLIKELY(!packet)) {
+                break;
+            }
+            packets[result++] = packet;
+        }
+
+        return result;
+    }
+
+    /// Read batch of up to `count` available packets
+    /// @see readPackets()
+    pcap::PacketBatch readBatch(std::size_t count)
+    {
+        if (batch_.size() < count) {
+            batch_.resize(count);
+        }
+        return {batch_.data(), readPackets(batch_.data(), count)};
+    }
+
+    /// Wait for packets
+    /// Packets read before are given back to kernel
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return True if packets available
+    bool wait(int timeout = -1) noexcept
+    {
+        releaseBlocks();
+        if (remaining_ > 0 || ready(head_)) {
+            return true;
+        }
+
+        pollfd fd{socket_.native(), POLLIN | POLLERR, 0};
+        if (::poll(&fd, 1, timeout) <= 0) {
+            return false;
+        }
+        return ready(head_);
+    }
+
+private:
+    tpacket_block_desc* block(std::size_t index) const noexcept
+    {
+        return reinterpret_cast< tpacket_block_desc* >(ring_.data() + (index % geometry_.blockCount) * geometry_.blockSize);
+    }
+
+    bool ready(std::size_t index) const noexcept
+    {
+        return __atomic_load_n(&block(index)->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER;
+    }
+
+    /// Give consumed blocks back to kernel
+    void releaseBlocks() noexcept
+    {
+        while (NETBOX_UNLIKELY(tail_ != head_)) {
+            __atomic_store_n(&block(tail_)->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+            tail_ += 1;
+        }
+    }
+
+    pcap::Packet nextPacket() noexcept
+    {
+        while (NETBOX_UNLIKELY(remaining_ == 0)) {
+            if (!ready(head_)) {
+                return {};
+            }
+            const auto& header = block(head_)->hdr.bh1;
+            frame_ = reinterpret_cast< const tpacket3_hdr* >(
+                    reinterpret_cast< const char* >(block(head_)) + header.offset_to_first_pkt);
+            remaining_ = header.num_pkts;
+            if (remaining_ == 0) {
+                head_ += 1;
+            }
+        }
+
+        const tpacket3_hdr* frame = frame_;
+        remaining_ -= 1;
+        if (remaining_ == 0) {
+            // Block consumed, given back on the next read
+            head_ += 1;
+        } else {
+            frame_ = reinterpret_cast< const tpacket3_hdr* >(
+                    reinterpret_cast< const char* >(frame) + frame->tp_next_offset);
+        }
+
+        const timespec timestamp{time_t(frame->tp_sec), long(frame->tp_nsec)};
+        return {timestamp, frame->tp_snaplen, frame->tp_len, reinterpret_cast< const char* >(frame) + frame->tp_mac};
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_PacketRing_181026180935 */
@@ -0,0 +1,244 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_PacketTxRing_181026185104
+#define KSERGEY_PacketTxRing_181026185104
+
+#include <net/if.h>
+#include <poll.h>
+#include <cstring>
+#include <string>
+
+#include <netbox/compiler.h>
+#include <netbox/details/MappedRegion.h>
+#include <netbox/details/RingGeometry.h>
+#include <netbox/exception.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+#include <netbox/socket_options.h>
+
+namespace netbox {
+
+/// PacketTxRing tuning
+struct PacketTxRingOptions
+{
+    /// Interface name to send to
+    std::string interface;
+
+    /// Ring memory size
+    std::size_t ringSize{16 * 1024 * 1024};
+
+    /// Size of ring block
+    std::size_t blockSize{64 * 1024};
+
+    /// Maximum size of packet (Ethernet header included)
+    std::size_t maxPacketSize{2048 - 32};
+
+    /// Send directly to the driver, bypassing qdisc layer (PACKET_QDISC_BYPASS)
+    bool qdiscBypass{false};
+};
+
+/// High rate packet transmission through TPACKET_V2 AF_PACKET TX ring
+/// Packets are copied into ring frames, the kernel sends all queued frames
+/// on a single `flush()` call. Malformed frames are dropped by the kernel.
+class PacketTxRing
+{
+private:
+    /// Offset of packet data inside frame
+    static constexpr std::size_t DataOffset = TPACKET2_HDRLEN - sizeof(sockaddr_ll);
+
+    Socket socket_;
+    details::RingGeometry geometry_;
+    details::MappedRegion ring_;
+
+    // Frame to fill next, counts up
+    std::size_t head_{0};
+    // Number of frames queued since the last flush
+    std::size_t queued_{0};
+
+public:
+    PacketTxRing(const PacketTxRing&) = delete;
+    PacketTxRing& operator=(const PacketTxRing&) = delete;
+
+    /// Create AF_PACKET socket, setup and map the ring
+    /// @param[in] options is ring tuning
+    /// @throw SocketError, SocketOptionError on error
+    explicit PacketTxRing(const PacketTxRingOptions& options)
+    {
+        const int ifindex = ::if_nametoindex(options.interface.c_str());
+        if (ifindex == 0) {
+            throwEx< SocketError >("if_nametoindex", errno);
+        }
+
+        // No protocol, the socket doesn't receive
+        socket_ = Socket::create(AF_PACKET, SOCK_RAW, 0);
+
+        if (auto result = setOption(socket_, Options::Packet::Version{TPACKET_V2}); !result) {
+            throwEx< SocketOptionError >("PACKET_VERSION", result);
+        }
+
+        if (auto result = setOption(socket_, Options::Packet::Loss{true}); !result) {
+            throwEx< SocketOptionError >("PACKET_LOSS", result);
+        }
+
+        if (options.qdiscBypass) {
+            if (auto result = setOption(socket_, Options::Packet::QdiscBypass{true}); !result) {
+                throwEx< SocketOptionError >("PACKET_QDISC_BYPASS", result);
+            }
+        }
+
+        geometry_ = details::RingGeometry::make(options.ringSize, options.blockSize,
+                details::RingGeometry::frameSizeFor(DataOffset, options.maxPacketSize));
+
+        tpacket_req req{};
+        req.tp_block_size = geometry_.blockSize;
+        req.tp_block_nr = geometry_.blockCount;
+        req.tp_frame_size = geometry_.frameSize;
+        req.tp_frame_nr = geometry_.frameCount;
+        if (auto result = setOption(socket_, Options::Packet::TxRing{req}); !result) {
+            throwEx< SocketOptionError >("PACKET_TX_RING", result);
+        }
+
+        ring_ = details::MappedRegion{geometry_.size(), PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, socket_.native(), 0};
+
+        sockaddr_ll address{};
+        address.sll_family = AF_PACKET;
+        address.sll_ifindex = ifindex;
+        if (::bind(socket_.native(), reinterpret_cast< const sockaddr* >(&address), sizeof(address)) != 0) {
+            throwEx< SocketError >("bind", errno);
+        }
+    }
+
+    /// Destructor
+    /// Queued but not flushed frames are not sent
+    ~PacketTxRing() noexcept = default;
+
+    /// Return ring socket
+    Socket& socket() noexcept
+    {
+        return socket_;
+    }
+
+    /// Return ring layout
+    const details::RingGeometry& geometry() const noexcept
+    {
+        return geometry_;
+    }
+
+    /// Return maximum size of packet fits into frame
+    std::size_t maxPacketSize() const noexcept
+    {
+        return geometry_.frameSize - DataOffset;
+    }
+
+    /// Return number of frames queued since the last flush
+    std::size_t queued() const noexcept
+    {
+        return queued_;
+    }
+
+    /// Return data buffer of the next free frame
+    /// The buffer holds up to `maxPacketSize()` bytes
+    /// @return Pointer to buffer or `nullptr` if ring full
+    void* acquire() noexcept
+    {
+        tpacket2_hdr* header = frame(head_);
+        if (NETBOX_UNLIKELY(__atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE)) {
+            return nullptr;
+        }
+        return reinterpret_cast< char* >(header) + DataOffset;
+    }
+
+    /// Queue frame returned by `acquire()` for sending
+    /// @param[in] size is packet size
+    /// @pre `size <= maxPacketSize()`
+    void commit(std::size_t size) noexcept
+    {
+        tpacket2_hdr* header = frame(head_);
+        header->tp_len = size;
+        __atomic_store_n(&header->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+        head_ += 1;
+        queued_ += 1;
+    }
+
+    /// Queue packet for sending
+    /// @return False if ring full or packet bigger than `maxPacketSize()`
+    bool write(const void* data, std::size_t size) noexcept
+    {
+        if (NETBOX_UNLIKELY(size > maxPacketSize())) {
+            return false;
+        }
+        void* buffer = acquire();
+        if (NETBOX_UNLIKELY(!buffer)) {
+            return false;
+        }
+        std::memcpy(buffer, data, size);
+        commit(size);
+        return true;
+    }
+
+    /// @overload
+    bool write(const pcap::Packet& packet) noexcept
+    {
+        return write(packet.data(), packet.captureLength());
+    }
+
+    /// Queue packets for sending
+    /// @return Number of packets queued, less than `count` if ring full
+    ///     (or packet bigger than `maxPacketSize()`)
+    std::size_t write(const pcap::Packet* packets, std::size_t count) noexcept
+    {
+        std::size_t result = 0;
+        while (result < count && write(packets[result])) {
+            result += 1;
+        }
+        return result;
+    }
+
+    /// @overload
+    std::size_t write(pcap::PacketBatch batch) noexcept
+    {
+        return write(batch.begin(), batch.size());
+    }
+
+    /// Ask the kernel to send queued frames
+    /// @param[in] block is true to return after all frames sent
+    /// @return Result of `send()`, bytes passed to the device (0 if nothing queued)
+    TransmitResult flush(bool block = false) noexcept
+    {
+        queued_ = 0;
+        return ::send(socket_.native(), nullptr, 0, block ? 0 : MSG_DONTWAIT);
+    }
+
+    /// Wait for free frame
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return True if free frame available
+    bool wait(int timeout = -1) noexcept
+    {
+        if (acquire()) {
+            return true;
+        }
+        pollfd fd{socket_.native(), POLLOUT | POLLERR, 0};
+        if (::poll(&fd, 1, timeout) <= 0) {
+            return false;
+        }
+        return acquire() != nullptr;
+    }
+
+private:
+    tpacket2_hdr* frame(std::size_t index) const noexcept
+    {
+        index %= geometry_.frameCount;
+        const std::size_t block = index / geometry_.framesPerBlock();
+        const std::size_t offset = (index % geometry_.framesPerBlock()) * geometry_.frameSize;
+        return reinterpret_cast< tpacket2_hdr* >(ring_.data() + block * geometry_.blockSize + offset);
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_PacketTxRing_181026185104 */
@@ -5,47 +5,67 @@
 #ifndef KSERGEY_PcapPacketSource_160918002835
 #define KSERGEY_PcapPacketSource_160918002835
 
+#include <cstring>
 #include <functional>
-#include <map>
+#include <limits>
 #include <vector>
 
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/pcap/PacketPool.h>
+#include <netbox/pcap/Prefetcher.h>
 #include <netbox/pcap/Reader.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/MergeQueue.h>
 
 namespace netbox {
-namespace details {
 
-/// Convert `timespec` to nanoseconds since Epoch
-inline std::uint64_t makeUnixTimeNs(const timespec& ts) noexcept
+/// PcapPacketSource tuning
+struct PcapPacketSourceOptions
 {
-    return ts.tv_sec * 1000000000ul + ts.tv_nsec;
-}
+    /// Tuning of file readers
+    utils::FileReaderOptions reader;
+
+    /// Number of threads reading files ahead, 0 - files read on the caller thread
+    unsigned prefetchThreads{0};
+
+    /// Size of block of prefetched packets
+    std::size_t prefetchBlockSize{1024 * 1024};
 
-} /* namespace details */
+    /// Number of prefetched blocks per file, bounds memory used by each file
+    std::size_t prefetchBlockCount{4};
+
+    /// Data capacity of pooled packet buffer (see `readNextPooledPacket()`)
+    std::size_t poolSlotSize{pcap::PacketPool::DefaultSlotSize};
+
+    /// Size of slab of pooled packet buffers
+    std::size_t poolSlabSize{pcap::PacketPool::DefaultSlabSize};
+};
 
 /// IP packets source
+/// Merges packets of several PCAP files by timestamp,
+/// packets with equal timestamps are ordered by file addition order.
 class PcapPacketSource
 {
 private:
-    struct Context
-    {
-        pcap::Packet packet;
-        pcap::Reader* reader{nullptr};
-
-        Context() = default;
-        Context(const pcap::Packet& p, pcap::Reader* r)
-            : packet{p}
-            , reader{r}
-        {}
-    };
+    static constexpr std::uint32_t NoReader = std::numeric_limits< std::uint32_t >::max();
 
     using ReaderPtr = std::unique_ptr< pcap::Reader >;
     using Storage = std::vector< ReaderPtr >;
-    using Queue = std::multimap< std::uint64_t, Context >;
 
+    PcapPacketSourceOptions options_;
+    // Readers of files, empty in prefetch mode
     Storage storage_;
-    Queue queue_;
-    Context current_;
+    std::unique_ptr< pcap::Prefetcher > prefetcher_;
+    // Head packet of each queued reader
+    std::vector< pcap::Packet > heads_;
+    // Readers except the current one
+    utils::MergeQueue queue_;
+    // Reader of the last returned packet
+    std::uint32_t current_{NoReader};
     std::function< void () > doneCallback_;
+    utils::Arena arena_;
+    std::vector< pcap::Packet > batch_;
+    pcap::PacketPool pool_{options_.poolSlotSize, options_.poolSlabSize};
 
 public:
     PcapPacketSource(const PcapPacketSource&) = delete;
@@ -53,6 +73,10 @@ public:
 
     PcapPacketSource() = default;
 
+    /// Construct packet source
+    /// @param[in] options is tuning of packet source
+    explicit PcapPacketSource(const PcapPacketSourceOptions& options);
+
     /// Return true if no more data available
     bool isDone() const noexcept;
 
@@ -66,41 +90,90 @@ public:
     /// The returned packet will be available until next call `readNextPacket()`
     pcap::Packet readNextPacket();
 
+    /// Read next available packet into pooled buffer
+    /// The returned packet could be retained beyond the next call and released
+    /// by any thread, this function itself should be called by one thread.
+    /// @see readNextPacket()
+    pcap::PooledPacket readNextPooledPacket();
+
+    /// Read up to `count` packets
+    /// Packets data copied into the arena able to hold `count` records,
+    /// packets will be available until next call `readPackets()` or `readBatch()`
+    /// @return Number of packets read, less than `count` only if no more packets
+    std::size_t readPackets(pcap::Packet* packets, std::size_t count);
+
+    /// Read batch of up to `count` packets
+    /// @see readPackets()
+    pcap::PacketBatch readBatch(std::size_t count);
+
+    /// Position source at the first packet with timestamp not less than `unixTimeNs`
+    /// Each file is positioned by `pcap::Reader::seek()`, the first seek may
+    /// build index of file by scanning it.
+    /// @return True if such packet found in any file
+    bool seek(std::uint64_t unixTimeNs);
+
     /// Set callback for end of stream reached
     template< class Callback >
     void setDoneCallback(Callback&& callback);
 
 private:
-    void returnToQueue(pcap::Reader* reader);
+    pcap::Packet readPacket(std::uint32_t index);
+    void returnToQueue(std::uint32_t index);
 };
 
+inline PcapPacketSource::PcapPacketSource(const PcapPacketSourceOptions& options)
+    : options_{options}
+{
+    if (options_.prefetchThreads > 0) {
+        prefetcher_ = std::make_unique< pcap::Prefetcher >(options_.prefetchThreads,
+                options_.prefetchBlockSize, options_.prefetchBlockCount);
+    }
+}
+
 inline bool PcapPacketSource::isDone() const noexcept
 {
-    return queue_.empty() && current_.reader == nullptr;
+    return queue_.empty() && current_ == NoReader;
 }
 
 inline void PcapPacketSource::addFile(const char* filename)
 {
-    auto reader = std::make_unique< pcap::Reader >(filename);
+    auto reader = std::make_unique< pcap::Reader >(filename, options_.reader);
     if (!*reader) {
         return debug("<WARN> File open error \"%s\"", filename);
     }
 
-    storage_.push_back(std::move(reader));
-    returnToQueue(storage_.back().get());
+    if (prefetcher_) {
+        prefetcher_->add(std::move(reader));
+    } else {
+        storage_.push_back(std::move(reader));
+    }
+    heads_.emplace_back();
+    queue_.reserve(heads_.size());
+    returnToQueue(heads_.size() - 1);
 }
 
 inline pcap::Packet PcapPacketSource::readNextPacket()
 {
-    // Push back front reader
-    if (NETBOX_LIKELY(current_.reader)) {
-        returnToQueue(current_.reader);
+    if (NETBOX_LIKELY(current_ != NoReader)) {
+        auto packet = readPacket(current_);
+        if (NETBOX_LIKELY(packet)) {
+            const utils::MergeQueue::Entry entry{details::makeUnixTimeNs(packet.timestamp()), current_};
+
+            // Fast path, current reader keeps winning
+            if (queue_.empty() || entry < queue_.top()) {
+                return packet;
+            }
+
+            // Swap current reader with the front one
+            heads_[current_] = packet;
+            current_ = queue_.top().source;
+            queue_.replaceTop(entry);
+            return heads_[current_];
+        }
+        current_ = NoReader;
     }
 
     if (NETBOX_UNLIKELY(queue_.empty())) {
-        // Reset current context
-        current_.reader = nullptr;
-
         // Notify no more data
         if (doneCallback_) {
             doneCallback_();
@@ -109,9 +182,57 @@ inline pcap::Packet PcapPacketSource::readNextPacket()
         return {};
     }
 
-    current_ = queue_.begin()->second;
-    queue_.erase(queue_.begin());
-    return current_.packet;
+    current_ = queue_.top().source;
+    queue_.pop();
+    return heads_[current_];
+}
+
+inline pcap::PooledPacket PcapPacketSource::readNextPooledPacket()
+{
+    return pool_.copy(readNextPacket());
+}
+
+inline std::size_t PcapPacketSource::readPackets(pcap::Packet* packets, std::size_t count)
+{
+    char* data = arena_.reserve(count * pcap::MaxSnapLen);
+
+    std::size_t result = 0;
+    while (result < count) {
+        auto packet = readNextPacket();
+        if (NETBOX_UNLIKELY(!packet)) {
+            break;
+        }
+        std::memcpy(data, packet.data(), packet.captureLength());
+        packets[result++] = pcap::Packet{packet.timestamp(), packet.captureLength(), packet.length(), data};
+        data += packet.captureLength();
+    }
+
+    return result;
+}
+
+inline pcap::PacketBatch PcapPacketSource::readBatch(std::size_t count)
+{
+    if (batch_.size() < count) {
+        batch_.resize(count);
+    }
+    return {batch_.data(), readPackets(batch_.data(), count)};
+}
+
+inline bool PcapPacketSource::seek(std::uint64_t unixTimeNs)
+{
+    queue_.clear();
+    current_ = NoReader;
+
+    for (std::uint32_t index = 0; index < heads_.size(); ++index) {
+        const bool found = prefetcher_
+            ? prefetcher_->seek(index, unixTimeNs)
+            : storage_[index]->seek(unixTimeNs);
+        if (found) {
+            returnToQueue(index);
+        }
+    }
+
+    return !queue_.empty();
 }
 
 template< class Callback >
@@ -120,13 +241,20 @@ void PcapPacketSource::setDoneCallback(Callback&& callback)
     doneCallback_ = std::move(callback);
 }
 
-inline void PcapPacketSource::returnToQueue(pcap::Reader* reader)
+inline pcap::Packet PcapPacketSource::readPacket(std::uint32_t index)
+{
+    if (prefetcher_) {
+        return prefetcher_->readPacket(index);
+    }
+    return storage_[index]->readPacket();
+}
+
+inline void PcapPacketSource::returnToQueue(std::uint32_t index)
 {
-    auto packet = reader->readPacket();
+    auto packet = readPacket(index);
     if (NETBOX_LIKELY(packet)) {
-        queue_.emplace(std::piecewise_construct,
-                std::forward_as_tuple(details::makeUnixTimeNs(packet.timestamp())),
-                std::forward_as_tuple(packet, reader));
+        heads_[index] = packet;
+        queue_.push({details::makeUnixTimeNs(packet.timestamp()), index});
     }
 }
 
@@ -0,0 +1,385 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Reactor_181026201530
+#define KSERGEY_Reactor_181026201530
+
+#include <sys/epoll.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/exception.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+
+namespace netbox {
+
+/// epoll event loop
+/// Handlers are registered by reference and invoked through a per-type
+/// function pointer, without virtual calls or type erasure allocations.
+/// Socket handler is callable `void(std::uint32_t events)`, timer handler
+/// is callable `void()`. Handlers should outlive their registration.
+/// Sockets and timers may be added and removed from handlers.
+/// @warning Not thread safe
+class Reactor
+{
+public:
+    /// Socket readiness events
+    enum Event : std::uint32_t
+    {
+        Readable    = EPOLLIN,
+        Writable    = EPOLLOUT,
+        PeerClosed  = EPOLLRDHUP,
+        HangUp      = EPOLLHUP,
+        Error       = EPOLLERR
+    };
+
+    /// Readiness notification mode
+    enum class Trigger
+    {
+        /// Notify while socket is ready
+        Level,
+        /// Notify when socket becomes ready, the handler should drain the socket
+        /// until `isTryAgain()`
+        Edge,
+        /// Notify once while socket is ready, `modify()` re-arms the socket
+        Once
+    };
+
+    /// Registered socket or timer identifier
+    struct Handle
+    {
+        std::uint32_t index{0};
+        std::uint32_t generation{0};
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Type erased handler reference
+    struct Slot
+    {
+        void* object{nullptr};
+        void (*callback)(void*, std::uint32_t){nullptr};
+        int fd{BadFd};
+        std::uint32_t generation{0};
+        // Position of timer in heap
+        std::size_t position{0};
+    };
+
+    /// Slot storage with reuse of released slots
+    struct Slots
+    {
+        std::vector< Slot > slots;
+        std::vector< std::uint32_t > free;
+
+        Handle acquire(void* object, void (*callback)(void*, std::uint32_t), int fd)
+        {
+            std::uint32_t index;
+            if (free.empty()) {
+                index = slots.size();
+                slots.emplace_back();
+            } else {
+                index = free.back();
+                free.pop_back();
+            }
+            Slot& slot = slots[index];
+            slot.object = object;
+            slot.callback = callback;
+            slot.fd = fd;
+            return {index, slot.generation};
+        }
+
+        Slot* find(Handle handle) noexcept
+        {
+            if (NETBOX_UNLIKELY(handle.index >= slots.size())) {
+                return nullptr;
+            }
+            Slot& slot = slots[handle.index];
+            return slot.callback && slot.generation == handle.generation ? &slot : nullptr;
+        }
+
+        void release(Handle handle)
+        {
+            Slot& slot = slots[handle.index];
+            slot.callback = nullptr;
+            slot.generation += 1;
+            free.push_back(handle.index);
+        }
+    };
+
+    /// Pending timer
+    struct Timer
+    {
+        std::int64_t deadline;
+        Handle handle;
+    };
+
+    Socket epoll_;
+    std::uint64_t id_;
+    std::vector< epoll_event > events_;
+    Slots sockets_;
+    Slots timers_;
+    // Min-heap by deadline, timer slot keeps its position
+    std::vector< Timer > heap_;
+    bool stopped_{false};
+
+public:
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /// Construct reactor
+    /// @param[in] maxEvents is maximum number of events fetched by one `epoll_wait()`
+    /// @throw SocketError on error
+    explicit Reactor(std::size_t maxEvents = 256)
+        : epoll_{::epoll_create1(EPOLL_CLOEXEC)}
+        , id_{nextId()}
+        , events_(std::max< std::size_t >(maxEvents, 1))
+    {
+        if (!epoll_) {
+            throwEx< SocketError >("epoll_create1", errno);
+        }
+    }
+
+    /// Return identifier of reactor, unique within process (never 0)
+    std::uint64_t id() const noexcept
+    {
+        return id_;
+    }
+
+    /// Register socket
+    /// @param[in] socket is socket to watch, should stay open while registered
+    /// @param[in] events is mask of `Event` to watch
+    /// @param[in] trigger is notification mode
+    /// @param[in] handler is callable `void(std::uint32_t events)`
+    /// @return Registration handle
+    /// @throw SocketError on error
+    template< class Handler >
+    Handle add(Socket& socket, std::uint32_t events, Trigger trigger, Handler& handler)
+    {
+        auto callback = [](void* object, std::uint32_t events) {
+            (*static_cast< Handler* >(object))(events);
+        };
+        const Handle handle = sockets_.acquire(&handler, callback, socket.native());
+        if (auto result = control(EPOLL_CTL_ADD, handle, events, trigger); !result) {
+            sockets_.release(handle);
+            throwEx< SocketError >("epoll_ctl", result.native());
+        }
+        return handle;
+    }
+
+    /// Change watched events of registered socket
+    OpResult modify(Handle handle, std::uint32_t events, Trigger trigger) noexcept
+    {
+        if (NETBOX_UNLIKELY(!sockets_.find(handle))) {
+            errno = ENOENT;
+            return OpResult{-1};
+        }
+        return control(EPOLL_CTL_MOD, handle, events, trigger);
+    }
+
+    /// Unregister socket, pending events of the socket are not dispatched
+    OpResult remove(Handle handle)
+    {
+        Slot* slot = sockets_.find(handle);
+        if (NETBOX_UNLIKELY(!slot)) {
+            errno = ENOENT;
+            return OpResult{-1};
+        }
+        OpResult result = ::epoll_ctl(epoll_.native(), EPOLL_CTL_DEL, slot->fd, nullptr);
+        sockets_.release(handle);
+        return result;
+    }
+
+    /// Schedule one-shot timer
+    /// @param[in] delay is time from now to invoke handler
+    /// @param[in] handler is callable `void()`
+    /// @return Timer handle
+    template< class Handler >
+    Handle addTimer(Clock::duration delay, Handler& handler)
+    {
+        auto callback = [](void* object, std::uint32_t) {
+            (*static_cast< Handler* >(object))();
+        };
+        const Handle handle = timers_.acquire(&handler, callback, BadFd);
+        heap_.push_back({now() + std::chrono::duration_cast< std::chrono::nanoseconds >(delay).count(), handle});
+        siftUp(heap_.size() - 1);
+        return handle;
+    }
+
+    /// Cancel timer
+    /// @return False if timer already fired or cancelled
+    bool cancelTimer(Handle handle)
+    {
+        Slot* slot = timers_.find(handle);
+        if (!slot) {
+            return false;
+        }
+        erase(slot->position);
+        timers_.release(handle);
+        return true;
+    }
+
+    /// Wait for events and dispatch them with expired timers
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return Number of handlers invoked, -1 on `epoll_wait` error (see errno)
+    int poll(int timeout = -1)
+    {
+        if (!heap_.empty()) {
+            // Round up, so the timer is expired after wake up
+            const std::int64_t wait = (heap_.front().deadline - now() + 999999) / 1000000;
+            const int timerTimeout = int(std::clamp< std::int64_t >(wait, 0, 1 << 30));
+            timeout = timeout < 0 ? timerTimeout : std::min(timeout, timerTimeout);
+        }
+
+        const int count = ::epoll_wait(epoll_.native(), events_.data(), events_.size(), timeout);
+        if (NETBOX_UNLIKELY(count < 0)) {
+            return errno == EINTR ? 0 : -1;
+        }
+
+        int result = 0;
+        for (int i = 0; i < count; ++i) {
+            const std::uint64_t data = events_[i].data.u64;
+            const Handle handle{std::uint32_t(data), std::uint32_t(data >> 32)};
+            // Socket might be removed by handler of previous event
+            if (Slot* slot = sockets_.find(handle); NETBOX_LIKELY(slot)) {
+                slot->callback(slot->object, events_[i].events);
+                result += 1;
+            }
+        }
+
+        return result + dispatchTimers();
+    }
+
+    /// Dispatch events until `stop()` called
+    /// @throw SocketError on `epoll_wait` error
+    void run()
+    {
+        stopped_ = false;
+        while (!stopped_) {
+            if (poll() < 0) {
+                throwEx< SocketError >("epoll_wait", errno);
+            }
+        }
+    }
+
+    /// Make `run()` return after current dispatch
+    void stop() noexcept
+    {
+        stopped_ = true;
+    }
+
+    /// Return number of pending timers
+    std::size_t pendingTimers() const noexcept
+    {
+        return heap_.size();
+    }
+
+private:
+    static std::uint64_t nextId() noexcept
+    {
+        static std::atomic< std::uint64_t > counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static std::int64_t now() noexcept
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >(Clock::now().time_since_epoch()).count();
+    }
+
+    OpResult control(int operation, Handle handle, std::uint32_t events, Trigger trigger) noexcept
+    {
+        epoll_event event{};
+        event.events = events;
+        if (trigger == Trigger::Edge) {
+            event.events |= EPOLLET;
+        } else if (trigger == Trigger::Once) {
+            event.events |= EPOLLONESHOT;
+        }
+        event.data.u64 = handle.index | (std::uint64_t(handle.generation) << 32);
+        return ::epoll_ctl(epoll_.native(), operation, sockets_.slots[handle.index].fd, &event);
+    }
+
+    void place(std::size_t position, const Timer& timer) noexcept
+    {
+        heap_[position] = timer;
+        timers_.slots[timer.handle.index].position = position;
+    }
+
+    void siftUp(std::size_t position) noexcept
+    {
+        const Timer timer = heap_[position];
+        while (position > 0) {
+            const std::size_t parent = (position - 1) / 2;
+            if (heap_[parent].deadline <= timer.deadline) {
+                break;
+            }
+            place(position, heap_[parent]);
+            position = parent;
+        }
+        place(position, timer);
+    }
+
+    void siftDown(std::size_t position) noexcept
+    {
+        const Timer timer = heap_[position];
+        while (true) {
+            std::size_t child = 2 * position + 1;
+            if (child >= heap_.size()) {
+                break;
+            }
+            if (child + 1 < heap_.size() && heap_[child + 1].deadline < heap_[child].deadline) {
+                child += 1;
+            }
+            if (timer.deadline <= heap_[child].deadline) {
+                break;
+            }
+            place(position, heap_[child]);
+            position = child;
+        }
+        place(position, timer);
+    }
+
+    /// Remove timer at `position` from heap
+    void erase(std::size_t position) noexcept
+    {
+        const Timer last = heap_.back();
+        heap_.pop_back();
+        if (position == heap_.size()) {
+            return;
+        }
+        place(position, last);
+        if (position > 0 && heap_[(position - 1) / 2].deadline > last.deadline) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+    }
+
+    int dispatchTimers()
+    {
+        int result = 0;
+        const std::int64_t time = now();
+        while (!heap_.empty() && heap_.front().deadline <= time) {
+            const Handle handle = heap_.front().handle;
+            erase(0);
+            // Release before call, so the handler can schedule itself again
+            Slot& slot = timers_.slots[handle.index];
+            void* object = slot.object;
+            auto callback = slot.callback;
+            timers_.release(handle);
+            callback(object, 0);
+            result += 1;
+        }
+        return result;
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_Reactor_181026201530 */
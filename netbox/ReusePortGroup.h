@@ -0,0 +1,185 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ReusePortGroup_181026205933
+#define KSERGEY_ReusePortGroup_181026205933
+
+#include <linux/filter.h>
+#include <poll.h>
+#include <vector>
+
+#include <netbox/details/WorkerGroup.h>
+#include <netbox/exception.h>
+#include <netbox/Socket.h>
+#include <netbox/socket_ops.h>
+#include <netbox/socket_options.h>
+
+namespace netbox {
+
+/// Distribution of connections (datagrams) between group sockets
+enum class ShardSteering
+{
+    /// Kernel default, by flow hash
+    Hash,
+    /// By CPU the packet processed on, socket `i` takes packets of `cpus[i]`,
+    /// packets of other CPUs are distributed by CPU number
+    Cpu
+};
+
+/// ReusePortGroup tuning
+struct ReusePortGroupOptions
+{
+    /// Socket type (`SOCK_DGRAM` or `SOCK_STREAM`)
+    int type{SOCK_DGRAM};
+
+    /// Number of sockets (and worker threads)
+    std::size_t shards{1};
+
+    /// Distribution mode
+    ShardSteering steering{ShardSteering::Hash};
+
+    /// CPU to pin worker `i` to is `cpus[i % cpus.size()]`, empty - no pinning
+    std::vector< int > cpus;
+
+    /// Listen backlog of stream sockets
+    int backlog{1024};
+
+    /// Time to wait for readiness before checking stop request (milliseconds)
+    int pollTimeout{100};
+};
+
+/// Group of sockets bound to the same address with SO_REUSEPORT
+/// The kernel distributes connections or datagrams between the sockets,
+/// each socket is served by its own (optionally pinned) worker thread,
+/// so there is no shared accept queue or receive lock.
+class ReusePortGroup
+{
+private:
+    ReusePortGroupOptions options_;
+    std::vector< Socket > sockets_;
+    // Declared after sockets, so workers stopped before sockets closed
+    details::WorkerGroup workers_;
+
+public:
+    ReusePortGroup(const ReusePortGroup&) = delete;
+    ReusePortGroup& operator=(const ReusePortGroup&) = delete;
+
+    /// Create, bind (and listen) group sockets, attach steering program
+    /// Sockets are non-blocking
+    /// @param[in] endpoint is address to bind to, port 0 - the same ephemeral port for all sockets
+    /// @param[in] options is group tuning
+    /// @throw SocketError, SocketOptionError on error
+    template< class Endpoint >
+    ReusePortGroup(const Endpoint& endpoint, const ReusePortGroupOptions& options)
+        : options_{options}
+        , sockets_(std::max< std::size_t >(options.shards, 1))
+        , workers_{sockets_.size()}
+    {
+        Endpoint bound = endpoint;
+        for (std::size_t i = 0; i < sockets_.size(); ++i) {
+            Socket& socket = sockets_[i];
+            socket = Socket::create(bound.data()->sa_family, options_.type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (auto result = setOption(socket, Options::Socket::ReusePort{true}); !result) {
+                throwEx< SocketOptionError >("SO_REUSEPORT", result);
+            }
+
+            // Preference hint for the listener lookup, the program below enforces it
+            if (options_.steering == ShardSteering::Cpu && i < options_.cpus.size()) {
+                if (auto result = setOption(socket, Options::Socket::IncomingCpu{options_.cpus[i]}); !result) {
+                    throwEx< SocketOptionError >("SO_INCOMING_CPU", result);
+                }
+            }
+
+            if (auto result = bind(socket, bound); !result) {
+                throwEx< SocketError >("bind", result.native());
+            }
+            if (i == 0) {
+                // Resolve ephemeral port for the rest of the group
+                socklen_t size = bound.size();
+                if (::getsockname(socket.native(), bound.data(), &size) != 0) {
+                    throwEx< SocketError >("getsockname", errno);
+                }
+            }
+            if (options_.type == SOCK_STREAM) {
+                if (auto result = listen(socket, options_.backlog); !result) {
+                    throwEx< SocketError >("listen", result.native());
+                }
+            }
+        }
+
+        if (options_.steering == ShardSteering::Cpu) {
+            attachCpuSteering();
+        }
+    }
+
+    /// Destructor, stops workers
+    ~ReusePortGroup() noexcept
+    {
+        workers_.shutdown();
+    }
+
+    /// Return number of sockets
+    std::size_t size() const noexcept
+    {
+        return sockets_.size();
+    }
+
+    /// Return socket of shard
+    /// @pre `index < size()`
+    Socket& socket(std::size_t index) noexcept
+    {
+        return sockets_[index];
+    }
+
+    /// Start worker threads, running workers are stopped first
+    /// Worker `i` calls `handler(i, socket)` when socket `i` becomes readable,
+    /// the handler should accept (receive) until `isTryAgain()`. The handler
+    /// is copied per worker, a worker stops on exception raised by its handler.
+    /// @param[in] handler is callable `void(std::size_t, Socket&)`
+    template< class Handler >
+    void start(Handler handler)
+    {
+        workers_.start(options_.cpus, [this, handler](std::size_t index) mutable {
+            Socket& socket = sockets_[index];
+            pollfd fd{socket.native(), POLLIN, 0};
+            if (::poll(&fd, 1, options_.pollTimeout) > 0) {
+                handler(index, socket);
+            }
+        });
+    }
+
+    /// Stop and join worker threads
+    /// @throw Rethrow the first exception raised by a handler
+    void stop()
+    {
+        workers_.stop();
+    }
+
+private:
+    /// Attach classic BPF program selecting socket by CPU
+    void attachCpuSteering()
+    {
+        const std::size_t mapped = std::min(options_.cpus.size(), sockets_.size());
+
+        std::vector< sock_filter > program;
+        program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, std::uint32_t(SKF_AD_OFF + SKF_AD_CPU)));
+        for (std::size_t i = 0; i < mapped; ++i) {
+            program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, std::uint32_t(options_.cpus[i]), 0, 1));
+            program.push_back(BPF_STMT(BPF_RET | BPF_K, std::uint32_t(i)));
+        }
+        program.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, std::uint32_t(sockets_.size())));
+        program.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+
+        // Program is shared by the group, attached through any member
+        sock_fprog fprog{std::uint16_t(program.size()), program.data()};
+        if (auto result = setOption(sockets_.front(), Options::Socket::AttachReusePortCBPF{fprog}); !result) {
+            throwEx< SocketOptionError >("SO_ATTACH_REUSEPORT_CBPF", result);
+        }
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_ReusePortGroup_181026205933 */
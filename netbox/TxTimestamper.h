@@ -0,0 +1,207 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_TxTimestamper_181026200247
+#define KSERGEY_TxTimestamper_181026200247
+
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/ControlMessages.h>
+#include <netbox/exception.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+#include <netbox/socket_ops.h>
+#include <netbox/socket_options.h>
+
+namespace netbox {
+
+/// Point of transmit path the timestamp taken at
+enum class TxTimestampType
+{
+    /// Before packet enters qdisc (`SOF_TIMESTAMPING_TX_SCHED`)
+    Sched = SCM_TSTAMP_SCHED,
+    /// When packet passed to the driver (`SOF_TIMESTAMPING_TX_SOFTWARE`)
+    Software = SCM_TSTAMP_SND,
+    /// When data acknowledged by peer (TCP only)
+    Ack = SCM_TSTAMP_ACK
+};
+
+/// Transmit timestamp of a send call
+struct TxTimestamp
+{
+    /// Send call identifier (`TxTimestamper::record()` result)
+    std::uint32_t id{0};
+    /// Point of transmit path
+    TxTimestampType type{TxTimestampType::Software};
+    /// Time packet reached the point
+    timespec timestamp{0, 0};
+    /// Time of `record()` call for the id, zero if unknown
+    timespec sent{0, 0};
+
+    /// Return nanoseconds from `record()` call to the timestamp, 0 if unknown
+    std::int64_t latency() const noexcept
+    {
+        if (sent.tv_sec == 0 && sent.tv_nsec == 0) {
+            return 0;
+        }
+        return (timestamp.tv_sec - sent.tv_sec) * std::int64_t(1000000000) + (timestamp.tv_nsec - sent.tv_nsec);
+    }
+};
+
+/// Software transmit timestamping of datagram socket sends
+/// Enables `SO_TIMESTAMPING` with `SOF_TIMESTAMPING_OPT_ID`, so the kernel
+/// numbers successful send calls starting from 0 and reports timestamps
+/// through the socket error queue. Sends should be done with `sendto()` or
+/// `sendmsg()` (or be paired with `record()` and `cancel()` on failure), the
+/// timestamper keeps send times of the last `history` sends to compute latency.
+class TxTimestamper
+{
+private:
+    Socket* socket_;
+    std::vector< timespec > sent_;
+    std::uint32_t next_{0};
+
+public:
+    TxTimestamper(const TxTimestamper&) = delete;
+    TxTimestamper& operator=(const TxTimestamper&) = delete;
+
+    /// Enable transmit timestamping on socket
+    /// @param[in] socket is datagram socket, should outlive the timestamper
+    /// @param[in] sched is true to also report timestamps before qdisc
+    /// @param[in] history is number of send times kept (rounded up to power of two)
+    /// @throw SocketOptionError on error
+    explicit TxTimestamper(Socket& socket, bool sched = false, std::size_t history = 4096)
+        : socket_{&socket}
+    {
+        std::size_t size = 1;
+        while (size < history) {
+            size <<= 1;
+        }
+        sent_.resize(size, timespec{0, 0});
+
+        int flags = SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+            | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+        if (sched) {
+            flags |= SOF_TIMESTAMPING_TX_SCHED;
+        }
+        if (auto result = setOption(socket, Options::Socket::Timestamping{flags}); !result) {
+            throwEx< SocketOptionError >("SO_TIMESTAMPING", result);
+        }
+    }
+
+    /// Register send call, should be called right before each send
+    /// The kernel numbers successful sends only, `cancel()` should be called if the send failed.
+    /// @return Identifier of the send reported back with its timestamps
+    std::uint32_t record() noexcept
+    {
+        timespec& sent = sent_[next_ & (sent_.size() - 1)];
+        ::clock_gettime(CLOCK_REALTIME, &sent);
+        return next_++;
+    }
+
+    /// Cancel the last `record()` call, its send failed
+    void cancel() noexcept
+    {
+        next_ -= 1;
+    }
+
+    /// Send datagram, the send time is recorded if sent
+    /// @return Send result, identifier of the send is `next() - 1` on success
+    TransmitResult sendto(const void* buf, std::size_t len, const sockaddr* addr, socklen_t addrlen) noexcept
+    {
+        record();
+        TransmitResult result = netbox::sendto(*socket_, buf, len, addr, addrlen);
+        if (NETBOX_UNLIKELY(!result)) {
+            cancel();
+        }
+        return result;
+    }
+
+    /// Send message, the send time is recorded if sent
+    /// @return Send result, identifier of the send is `next() - 1` on success
+    TransmitResult sendmsg(const msghdr* message) noexcept
+    {
+        record();
+        TransmitResult result = netbox::sendmsg(*socket_, message);
+        if (NETBOX_UNLIKELY(!result)) {
+            cancel();
+        }
+        return result;
+    }
+
+    /// Return identifier of the next send
+    std::uint32_t next() const noexcept
+    {
+        return next_;
+    }
+
+    /// Wait for timestamps in error queue
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return True if timestamps available
+    bool wait(int timeout = -1) noexcept
+    {
+        // Error queue readiness is reported as POLLERR
+        pollfd fd{socket_->native(), 0, 0};
+        return ::poll(&fd, 1, timeout) > 0 && (fd.revents & POLLERR);
+    }
+
+    /// Read all timestamps available in error queue
+    /// @param[in] handler is callable `void(const TxTimestamp&)`
+    /// @return Number of timestamps read
+    template< class Handler >
+    std::size_t drain(Handler&& handler)
+    {
+        union {
+            char data[CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+            cmsghdr align;
+        } control;
+
+        std::size_t result = 0;
+        while (true) {
+            msghdr message{};
+            message.msg_control = control.data;
+            message.msg_controllen = sizeof(control.data);
+            if (::recvmsg(socket_->native(), &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1) {
+                break;
+            }
+
+            const scm_timestamping* timestamps = nullptr;
+            const sock_extended_err* error = nullptr;
+            for (auto cmsg: ControlMessages{message}) {
+                if (cmsg.is(SOL_SOCKET, SCM_TIMESTAMPING)) {
+                    timestamps = static_cast< const scm_timestamping* >(cmsg.data());
+                } else if (cmsg.is(SOL_IP, IP_RECVERR) || cmsg.is(SOL_IPV6, IPV6_RECVERR)) {
+                    error = static_cast< const sock_extended_err* >(cmsg.data());
+                }
+            }
+            if (NETBOX_UNLIKELY(!timestamps || !error
+                        || error->ee_errno != ENOMSG || error->ee_origin != SO_EE_ORIGIN_TIMESTAMPING)) {
+                continue;
+            }
+
+            TxTimestamp timestamp;
+            timestamp.id = error->ee_data;
+            timestamp.type = TxTimestampType(error->ee_info);
+            timestamp.timestamp = timestamps->ts[0];
+            // Send time is known if not overwritten by later sends
+            if (next_ - timestamp.id <= sent_.size()) {
+                timestamp.sent = sent_[timestamp.id & (sent_.size() - 1)];
+            }
+            handler(timestamp);
+            result += 1;
+        }
+        return result;
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_TxTimestamper_181026200247 */
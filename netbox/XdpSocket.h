@@ -0,0 +1,376 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_XdpSocket_181026192533
+#define KSERGEY_XdpSocket_181026192533
+
+#include <net/if.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <ctime>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/details/bpf.h>
+#include <netbox/details/MappedRegion.h>
+#include <netbox/details/XdpRing.h>
+#include <netbox/exception.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+#include <netbox/socket_options.h>
+
+namespace netbox {
+
+/// XdpSocket tuning
+struct XdpSocketOptions
+{
+    /// Interface name to bind to
+    std::string interface;
+
+    /// Interface receive queue to bind to
+    std::uint32_t queue{0};
+
+    /// Number of entries of each ring (power of two)
+    std::uint32_t ringSize{2048};
+
+    /// Size of UMEM frame (power of two, from 2048 up to page size)
+    std::uint32_t frameSize{4096};
+
+    /// Load and attach XDP program redirecting `queue` packets to the socket
+    /// The program is detached when the socket destroyed
+    bool attachProgram{true};
+};
+
+/// AF_XDP socket counters
+struct XdpSocketStatistics
+{
+    /// Packets dropped because of no free RX frames (fill ring empty)
+    std::uint64_t rxDropped{0};
+    /// Packets dropped because the RX ring was full
+    std::uint64_t rxRingFull{0};
+    /// Invalid descriptors
+    std::uint64_t rxInvalid{0};
+    std::uint64_t txInvalid{0};
+};
+
+/// AF_XDP socket in generic (copy) mode
+/// UMEM holds `2 * ringSize` frames: the first half is handed to the kernel
+/// through the fill ring for reception, the second half is used for
+/// transmission. Received packets point into UMEM, their frames are given
+/// back to the kernel on the receive call following the one returned them.
+class XdpSocket
+{
+private:
+    // Declared first, so unmapped after socket closed and program detached
+    details::MappedRegion umem_;
+    Socket socket_;
+    std::uint32_t frameSize_{0};
+
+    details::XdpRing< std::uint64_t > fill_;
+    details::XdpRing< std::uint64_t > completion_;
+    details::XdpRing< xdp_desc > rx_;
+    details::XdpRing< xdp_desc > tx_;
+
+    // RX descriptors returned to user, recycled on the next receive
+    std::uint32_t rxIndex_{0};
+    std::uint32_t rxPending_{0};
+
+    // Free TX frames
+    std::vector< std::uint64_t > txFrames_;
+    std::uint32_t txQueued_{0};
+
+    std::vector< pcap::Packet > batch_;
+
+    details::BpfObject map_;
+    details::BpfObject program_;
+    details::BpfObject link_;
+
+public:
+    XdpSocket(const XdpSocket&) = delete;
+    XdpSocket& operator=(const XdpSocket&) = delete;
+
+    /// Create AF_XDP socket, register UMEM, map the rings and bind to interface queue
+    /// @param[in] options is socket tuning
+    /// @throw SocketError, SocketOptionError on error
+    explicit XdpSocket(const XdpSocketOptions& options)
+        : frameSize_{options.frameSize}
+    {
+        const std::uint32_t ringSize = options.ringSize;
+        if (ringSize == 0 || (ringSize & (ringSize - 1)) != 0) {
+            throwEx< SocketError >("XdpSocket ring size", EINVAL);
+        }
+        if (frameSize_ < 2048 || (frameSize_ & (frameSize_ - 1)) != 0 || long(frameSize_) > ::sysconf(_SC_PAGESIZE)) {
+            throwEx< SocketError >("XdpSocket frame size", EINVAL);
+        }
+
+        const int ifindex = ::if_nametoindex(options.interface.c_str());
+        if (ifindex == 0) {
+            throwEx< SocketError >("if_nametoindex", errno);
+        }
+
+        umem_ = details::MappedRegion{std::size_t(2) * ringSize * frameSize_, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0};
+
+        socket_ = Socket::create(AF_XDP, SOCK_RAW, 0);
+
+        xdp_umem_reg reg{};
+        reg.addr = reinterpret_cast< std::uintptr_t >(umem_.data());
+        reg.len = umem_.size();
+        reg.chunk_size = frameSize_;
+        if (auto result = setOption(socket_, Options::Xdp::UmemReg{reg}); !result) {
+            throwEx< SocketOptionError >("XDP_UMEM_REG", result);
+        }
+
+        if (auto result = setOption(socket_, Options::Xdp::FillRing{int(ringSize)}); !result) {
+            throwEx< SocketOptionError >("XDP_UMEM_FILL_RING", result);
+        }
+        if (auto result = setOption(socket_, Options::Xdp::CompletionRing{int(ringSize)}); !result) {
+            throwEx< SocketOptionError >("XDP_UMEM_COMPLETION_RING", result);
+        }
+        if (auto result = setOption(socket_, Options::Xdp::RxRing{int(ringSize)}); !result) {
+            throwEx< SocketOptionError >("XDP_RX_RING", result);
+        }
+        if (auto result = setOption(socket_, Options::Xdp::TxRing{int(ringSize)}); !result) {
+            throwEx< SocketOptionError >("XDP_TX_RING", result);
+        }
+
+        Options::Xdp::MmapOffsets offsets;
+        if (auto result = getOption(socket_, offsets); !result) {
+            throwEx< SocketOptionError >("XDP_MMAP_OFFSETS", result);
+        }
+
+        const int fd = socket_.native();
+        fill_ = details::XdpRing< std::uint64_t >{fd, offsets.value().fr, ringSize, XDP_UMEM_PGOFF_FILL_RING};
+        completion_ = details::XdpRing< std::uint64_t >{fd, offsets.value().cr, ringSize, XDP_UMEM_PGOFF_COMPLETION_RING};
+        rx_ = details::XdpRing< xdp_desc >{fd, offsets.value().rx, ringSize, XDP_PGOFF_RX_RING};
+        tx_ = details::XdpRing< xdp_desc >{fd, offsets.value().tx, ringSize, XDP_PGOFF_TX_RING};
+
+        // The first half of UMEM to receive
+        std::uint32_t index = 0;
+        if (!fill_.reserve(ringSize, index)) {
+            throwEx< SocketError >("XdpSocket fill ring", ENOBUFS);
+        }
+        for (std::uint32_t i = 0; i < ringSize; ++i) {
+            fill_[index + i] = std::uint64_t(i) * frameSize_;
+        }
+        fill_.submit();
+
+        // The second half to send
+        txFrames_.reserve(ringSize);
+        for (std::uint32_t i = 0; i < ringSize; ++i) {
+            txFrames_.push_back(std::uint64_t(ringSize + i) * frameSize_);
+        }
+
+        sockaddr_xdp address{};
+        address.sxdp_family = AF_XDP;
+        address.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+        address.sxdp_ifindex = ifindex;
+        address.sxdp_queue_id = options.queue;
+        if (::bind(fd, reinterpret_cast< const sockaddr* >(&address), sizeof(address)) != 0) {
+            throwEx< SocketError >("bind", errno);
+        }
+
+        if (options.attachProgram) {
+            map_ = details::createXskMap(options.queue + 1);
+            details::updateMap(map_, options.queue, fd);
+            program_ = details::loadXskRedirectProgram(map_);
+            link_ = details::attachXdp(program_, ifindex, XDP_FLAGS_SKB_MODE);
+        }
+    }
+
+    /// Destructor, detaches XDP program and releases UMEM
+    ~XdpSocket() noexcept = default;
+
+    /// Return AF_XDP socket
+    Socket& socket() noexcept
+    {
+        return socket_;
+    }
+
+    /// Return maximum size of packet to send
+    std::size_t maxPacketSize() const noexcept
+    {
+        return frameSize_;
+    }
+
+    /// Return socket counters
+    /// @throw SocketOptionError on error
+    XdpSocketStatistics statistics()
+    {
+        Options::Xdp::Statistics option;
+        if (auto result = getOption(socket_, option); !result) {
+            throwEx< SocketOptionError >("XDP_STATISTICS", result);
+        }
+        XdpSocketStatistics result;
+        result.rxDropped = option.value().rx_dropped;
+        result.rxRingFull = option.value().rx_ring_full;
+        result.rxInvalid = option.value().rx_invalid_descs;
+        result.txInvalid = option.value().tx_invalid_descs;
+        return result;
+    }
+
+    /// Receive up to `count` available packets
+    /// Packets point into UMEM and will be available until next receive
+    /// AF_XDP provides no timestamps, packets are stamped with the receive time
+    /// @return Number of packets received
+    std::size_t receive(pcap::Packet* packets, std::size_t count) noexcept
+    {
+        if (NETBOX_UNLIKELY(!recycle())) {
+            return 0;
+        }
+
+        std::uint32_t index = 0;
+        const std::uint32_t received = rx_.peek(std::min< std::size_t >(count, rx_.size()), index);
+        if (received == 0) {
+            if (fill_.needWakeup()) {
+                ::recvfrom(socket_.native(), nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+            }
+            return 0;
+        }
+        rxIndex_ = index;
+        rxPending_ = received;
+
+        timespec timestamp;
+        ::clock_gettime(CLOCK_REALTIME, &timestamp);
+        for (std::uint32_t i = 0; i < received; ++i) {
+            const xdp_desc& desc = rx_[index + i];
+            packets[i] = {timestamp, desc.len, desc.len, umem_.data() + desc.addr};
+        }
+
+        return received;
+    }
+
+    /// Receive batch of up to `count` available packets
+    /// @see receive()
+    pcap::PacketBatch receiveBatch(std::size_t count)
+    {
+        if (batch_.size() < count) {
+            batch_.resize(count);
+        }
+        return {batch_.data(), receive(batch_.data(), count)};
+    }
+
+    /// Wait for packets
+    /// Packets received before are given back to kernel
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return True if packets available
+    bool wait(int timeout = -1) noexcept
+    {
+        recycle();
+        pollfd fd{socket_.native(), POLLIN | POLLERR, 0};
+        return ::poll(&fd, 1, timeout) > 0 && (fd.revents & POLLIN);
+    }
+
+    /// Queue packet for sending
+    /// @return False if no free TX frame or packet bigger than `maxPacketSize()`
+    bool write(const void* data, std::size_t size) noexcept
+    {
+        if (NETBOX_UNLIKELY(size > frameSize_)) {
+            return false;
+        }
+        if (NETBOX_UNLIKELY(txFrames_.empty())) {
+            complete();
+            if (txFrames_.empty()) {
+                return false;
+            }
+        }
+
+        // TX ring has room for all TX frames
+        std::uint32_t index = 0;
+        if (NETBOX_UNLIKELY(!tx_.reserve(1, index))) {
+            return false;
+        }
+
+        const std::uint64_t address = txFrames_.back();
+        txFrames_.pop_back();
+        std::memcpy(umem_.data() + address, data, size);
+        tx_[index] = xdp_desc{address, std::uint32_t(size), 0};
+        txQueued_ += 1;
+        return true;
+    }
+
+    /// @overload
+    bool write(const pcap::Packet& packet) noexcept
+    {
+        return write(packet.data(), packet.captureLength());
+    }
+
+    /// Queue packets for sending
+    /// @return Number of packets queued
+    std::size_t write(pcap::PacketBatch batch) noexcept
+    {
+        std::size_t result = 0;
+        while (result < batch.size() && write(batch[result])) {
+            result += 1;
+        }
+        return result;
+    }
+
+    /// Ask the kernel to send queued packets and reclaim frames of sent ones
+    /// In copy mode the kernel sends a limited number of packets per call,
+    /// `flush()` should be called again while `inflight()` is not zero
+    /// @return Result of `sendto()` kick, `EAGAIN` or `EBUSY` if the kernel
+    ///     didn't take all packets yet
+    OpResult flush() noexcept
+    {
+        if (txQueued_ > 0) {
+            tx_.submit();
+            txQueued_ = 0;
+        }
+        OpResult result{0};
+        if (inflight() > 0) {
+            result = int(::sendto(socket_.native(), nullptr, 0, MSG_DONTWAIT, nullptr, 0));
+            complete();
+        }
+        return result;
+    }
+
+    /// Return number of packets passed to the kernel and not sent yet
+    std::size_t inflight() const noexcept
+    {
+        return tx_.size() - txFrames_.size() - txQueued_;
+    }
+
+private:
+    /// Give frames of previously received packets back to kernel
+    /// @return False if fill ring has no room, the frames are kept pending
+    bool recycle() noexcept
+    {
+        if (rxPending_ == 0) {
+            return true;
+        }
+        // Fill ring has room for all RX frames
+        std::uint32_t index = 0;
+        if (NETBOX_UNLIKELY(!fill_.reserve(rxPending_, index))) {
+            return false;
+        }
+        for (std::uint32_t i = 0; i < rxPending_; ++i) {
+            fill_[index + i] = rx_[rxIndex_ + i].addr & ~std::uint64_t(frameSize_ - 1);
+        }
+        fill_.submit();
+        rx_.release();
+        rxPending_ = 0;
+        return true;
+    }
+
+    /// Reclaim frames of sent packets
+    void complete() noexcept
+    {
+        std::uint32_t index = 0;
+        const std::uint32_t count = completion_.peek(completion_.size(), index);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            txFrames_.push_back(completion_[index + i]);
+        }
+        completion_.release();
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_XdpSocket_181026192533 */
@@ -0,0 +1,256 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ZeroCopySender_181026211206
+#define KSERGEY_ZeroCopySender_181026211206
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <cstdint>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/ControlMessages.h>
+#include <netbox/debug.h>
+#include <netbox/result.h>
+#include <netbox/Socket.h>
+#include <netbox/socket_options.h>
+
+namespace netbox {
+
+/// ZeroCopySender tuning
+struct ZeroCopySenderOptions
+{
+    /// Maximum number of sends waiting for completion (rounded up to power of two)
+    std::size_t maxPending{1024};
+
+    /// Number of consecutive completions the kernel copied data for, after
+    /// which sends fall back to regular copying ones, 0 - never fall back
+    std::size_t copiedLimit{64};
+};
+
+/// ZeroCopySender counters
+struct ZeroCopyStatistics
+{
+    /// Send calls
+    std::uint64_t sends{0};
+    /// Send calls made with MSG_ZEROCOPY
+    std::uint64_t zerocopySends{0};
+    /// MSG_ZEROCOPY sends the kernel copied data for anyway
+    std::uint64_t copied{0};
+};
+
+/// MSG_ZEROCOPY sender
+/// Sent buffers are pinned by the kernel and should stay unchanged until
+/// their completion reported by `complete()`. Completions are reported in
+/// send order with the token passed to `send()`, so buffers can be returned
+/// to a pool. When SO_ZEROCOPY is not supported or the kernel keeps copying
+/// (i.e. loopback), sends fall back to regular ones and complete immediately.
+/// @warning Not thread safe
+class ZeroCopySender
+{
+private:
+    struct Entry
+    {
+        std::uint64_t token;
+        // Kernel notification id, valid for zerocopy sends
+        std::uint32_t id;
+        bool zerocopy;
+        bool done;
+        bool copied;
+    };
+
+    Socket* socket_;
+    ZeroCopySenderOptions options_;
+    std::vector< Entry > pending_;
+    // Position of zerocopy entry in `pending_` by notification id,
+    // there are no more zerocopy entries in flight than `pending_` size
+    std::vector< std::size_t > positions_;
+    // Oldest and next entry, count up
+    std::size_t tail_{0};
+    std::size_t head_{0};
+    // Kernel notification id of the next zerocopy send
+    std::uint32_t nextId_{0};
+    bool zerocopy_{false};
+    std::size_t copiedInRow_{0};
+    ZeroCopyStatistics statistics_;
+
+public:
+    ZeroCopySender(const ZeroCopySender&) = delete;
+    ZeroCopySender& operator=(const ZeroCopySender&) = delete;
+
+    /// Enable SO_ZEROCOPY on socket
+    /// @param[in] socket is connected stream (or datagram) socket, should outlive the sender
+    /// @param[in] options is sender tuning
+    explicit ZeroCopySender(Socket& socket, const ZeroCopySenderOptions& options = {})
+        : socket_{&socket}
+        , options_{options}
+    {
+        std::size_t size = 1;
+        while (size < options_.maxPending) {
+            size <<= 1;
+        }
+        pending_.resize(size);
+        positions_.resize(size);
+
+        if (auto result = setOption(socket, Options::Socket::ZeroCopy{true}); result) {
+            zerocopy_ = true;
+        } else {
+            debug("<WARN> SO_ZEROCOPY not available (%s), sends will copy", result.str());
+        }
+    }
+
+    /// Return true if sends are zerocopy
+    bool zerocopy() const noexcept
+    {
+        return zerocopy_;
+    }
+
+    /// Return number of sends not reported by `complete()` yet
+    std::size_t pending() const noexcept
+    {
+        return head_ - tail_;
+    }
+
+    /// Return sender counters
+    const ZeroCopyStatistics& statistics() const noexcept
+    {
+        return statistics_;
+    }
+
+    /// Send data
+    /// On partial send the buffer is still owned by kernel until completion,
+    /// the rest should be sent with another call (and token).
+    /// @param[in] buf is data to send, should stay unchanged until completion
+    /// @param[in] len is size of data
+    /// @param[in] token is value reported on completion
+    /// @param[in] flags is additional `send()` flags
+    /// @return Result of `send()`, `ENOBUFS` if too many pending sends
+    ///     (call `complete()` to reap them)
+    TransmitResult send(const void* buf, std::size_t len, std::uint64_t token, int flags = 0) noexcept
+    {
+        if (NETBOX_UNLIKELY(pending() == pending_.size())) {
+            errno = ENOBUFS;
+            return -1;
+        }
+
+        const bool zerocopy = zerocopy_;
+        TransmitResult result = ::send(socket_->native(), buf, len, flags | MSG_NOSIGNAL | (zerocopy ? MSG_ZEROCOPY : 0));
+        if (NETBOX_UNLIKELY(result.native() != 0)) {
+            return result;
+        }
+
+        statistics_.sends += 1;
+        Entry& entry = pending_[head_ & (pending_.size() - 1)];
+        entry.token = token;
+        entry.zerocopy = zerocopy;
+        entry.done = !zerocopy;
+        entry.copied = !zerocopy;
+        if (zerocopy) {
+            entry.id = nextId_++;
+            positions_[entry.id & (positions_.size() - 1)] = head_;
+            statistics_.zerocopySends += 1;
+        }
+        head_ += 1;
+        return result;
+    }
+
+    /// Wait for completions
+    /// @param[in] timeout is wait timeout (milliseconds), -1 - infinite
+    /// @return True if completions available
+    bool wait(int timeout = -1) noexcept
+    {
+        if (pending() > 0 && pending_[tail_ & (pending_.size() - 1)].done) {
+            return true;
+        }
+        // Error queue readiness is reported as POLLERR
+        pollfd fd{socket_->native(), 0, 0};
+        return ::poll(&fd, 1, timeout) > 0 && (fd.revents & POLLERR);
+    }
+
+    /// Read completion notifications and report completed sends in send order
+    /// @param[in] handler is callable `void(std::uint64_t token, bool copied)`,
+    ///     buffer of the send can be reused when called
+    /// @return Number of sends reported
+    template< class Handler >
+    std::size_t complete(Handler&& handler)
+    {
+        readNotifications();
+
+        std::size_t result = 0;
+        while (tail_ != head_) {
+            const Entry& entry = pending_[tail_ & (pending_.size() - 1)];
+            if (!entry.done) {
+                break;
+            }
+            tail_ += 1;
+            handler(entry.token, entry.copied);
+            result += 1;
+        }
+        return result;
+    }
+
+private:
+    void readNotifications() noexcept
+    {
+        union {
+            char data[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+            cmsghdr align;
+        } control;
+
+        while (true) {
+            msghdr message{};
+            message.msg_control = control.data;
+            message.msg_controllen = sizeof(control.data);
+            if (::recvmsg(socket_->native(), &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1) {
+                break;
+            }
+
+            for (auto cmsg: ControlMessages{message}) {
+                if (!cmsg.is(SOL_IP, IP_RECVERR) && !cmsg.is(SOL_IPV6, IPV6_RECVERR)) {
+                    continue;
+                }
+                sock_extended_err error;
+                if (!cmsg.get(error) || error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                    continue;
+                }
+                // Inclusive range of completed notification ids
+                markDone(error.ee_info, error.ee_data, error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+            }
+        }
+    }
+
+    void markDone(std::uint32_t first, std::uint32_t last, bool copied) noexcept
+    {
+        const std::uint32_t count = last - first + 1;
+        for (std::uint32_t id = first; id != last + 1; ++id) {
+            const std::size_t position = positions_[id & (positions_.size() - 1)];
+            if (NETBOX_UNLIKELY(position - tail_ >= pending())) {
+                continue;
+            }
+            Entry& entry = pending_[position & (pending_.size() - 1)];
+            // Skip stale ids, the slot could be taken by a newer send
+            if (NETBOX_LIKELY(entry.zerocopy && entry.id == id)) {
+                entry.done = true;
+                entry.copied = copied;
+            }
+        }
+
+        if (copied) {
+            statistics_.copied += count;
+            copiedInRow_ += count;
+            if (options_.copiedLimit != 0 && copiedInRow_ >= options_.copiedLimit && zerocopy_) {
+                zerocopy_ = false;
+                debug("<WARN> Kernel copies zerocopy sends, falling back to regular sends");
+            }
+        } else {
+            copiedInRow_ = 0;
+        }
+    }
+};
+
+} /* namespace netbox */
+
+#endif /* KSERGEY_ZeroCopySender_181026211206 */
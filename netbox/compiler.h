@@ -17,4 +17,8 @@
 #   define NETBOX_FORCE_INLINE inline __attribute__((always_inline))
 #endif
 
+#ifndef NETBOX_CACHE_LINE_SIZE
+#   define NETBOX_CACHE_LINE_SIZE 64
+#endif
+
 #endif /* KSERGEY_compiler_140318105608 */
@@ -0,0 +1,86 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_MappedRegion_191026101205
+#define KSERGEY_MappedRegion_191026101205
+
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstddef>
+#include <utility>
+
+#include <netbox/exception.h>
+
+namespace netbox::details {
+
+/// Owned memory mapping (kernel ring, anonymous memory, ...)
+class MappedRegion
+{
+private:
+    void* data_{nullptr};
+    std::size_t size_{0};
+
+public:
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+
+    /// Move constructor
+    MappedRegion(MappedRegion&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}
+        , size_{std::exchange(other.size_, 0)}
+    {}
+
+    /// Move operator
+    MappedRegion& operator=(MappedRegion&& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    /// Construct empty region
+    MappedRegion() = default;
+
+    /// Map region, arguments are the ones of `mmap()`
+    /// @throw SocketError on error
+    MappedRegion(std::size_t size, int prot, int flags, int fd, off_t offset)
+    {
+        void* data = ::mmap(nullptr, size, prot, flags, fd, offset);
+        if (data == MAP_FAILED) {
+            throwEx< SocketError >("mmap", errno);
+        }
+        data_ = data;
+        size_ = size;
+    }
+
+    /// Destructor, unmaps the region
+    ~MappedRegion() noexcept
+    {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    /// Return true if region mapped
+    explicit operator bool() const noexcept
+    {
+        return data_ != nullptr;
+    }
+
+    /// Return region memory
+    char* data() const noexcept
+    {
+        return static_cast< char* >(data_);
+    }
+
+    /// Return region size
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+};
+
+} /* namespace netbox::details */
+
+#endif /* KSERGEY_MappedRegion_191026101205 */
@@ -0,0 +1,70 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_RingGeometry_181026180412
+#define KSERGEY_RingGeometry_181026180412
+
+#include <unistd.h>
+#include <linux/if_packet.h>
+#include <algorithm>
+#include <cstddef>
+
+namespace netbox::details {
+
+/// Memory layout of AF_PACKET ring (PACKET_RX_RING / PACKET_TX_RING)
+/// The ring is `blockCount` blocks of `blockSize` bytes, each block
+/// is split into frames of `frameSize` bytes.
+struct RingGeometry
+{
+    std::size_t blockSize{0};
+    std::size_t blockCount{0};
+    std::size_t frameSize{0};
+    std::size_t frameCount{0};
+
+    /// Return ring memory size
+    constexpr std::size_t size() const noexcept
+    {
+        return blockSize * blockCount;
+    }
+
+    /// Return number of frames in block
+    constexpr std::size_t framesPerBlock() const noexcept
+    {
+        return blockSize / frameSize;
+    }
+
+    /// Compute ring layout satisfying kernel constraints
+    /// Frame size is aligned to `TPACKET_ALIGNMENT`, block size is rounded up to
+    /// power of two number of pages (kernel allocates blocks of such size anyway)
+    /// and holds at least one frame.
+    /// @param[in] ringSize is minimal ring memory size
+    /// @param[in] blockSize is minimal block size
+    /// @param[in] frameSize is minimal frame size (frame header included)
+    static RingGeometry make(std::size_t ringSize, std::size_t blockSize, std::size_t frameSize) noexcept
+    {
+        RingGeometry result;
+
+        result.frameSize = TPACKET_ALIGN(std::max< std::size_t >(frameSize, TPACKET_ALIGNMENT));
+
+        const std::size_t pageSize = ::sysconf(_SC_PAGESIZE);
+        result.blockSize = pageSize;
+        while (result.blockSize < std::max(blockSize, result.frameSize)) {
+            result.blockSize *= 2;
+        }
+
+        result.blockCount = std::max< std::size_t >((ringSize + result.blockSize - 1) / result.blockSize, 1);
+        result.frameCount = result.blockCount * result.framesPerBlock();
+        return result;
+    }
+
+    /// Return frame size holding packet of `packetSize` bytes after header of `headerSize` bytes
+    static constexpr std::size_t frameSizeFor(std::size_t headerSize, std::size_t packetSize) noexcept
+    {
+        return TPACKET_ALIGN(headerSize) + TPACKET_ALIGN(packetSize);
+    }
+};
+
+} /* namespace netbox::details */
+
+#endif /* KSERGEY_RingGeometry_181026180412 */
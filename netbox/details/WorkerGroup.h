@@ -0,0 +1,118 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_WorkerGroup_191026113047
+#define KSERGEY_WorkerGroup_191026113047
+
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/debug.h>
+
+namespace netbox::details {
+
+/// Fixed number of worker threads, each optionally pinned to CPU
+/// Worker `i` calls `body(i)` in a loop until stop requested.
+class WorkerGroup
+{
+private:
+    struct Worker
+    {
+        std::thread thread;
+        std::exception_ptr error;
+    };
+
+    std::vector< Worker > workers_;
+    std::atomic< bool > stop_{false};
+
+public:
+    WorkerGroup(const WorkerGroup&) = delete;
+    WorkerGroup& operator=(const WorkerGroup&) = delete;
+
+    /// Construct group of `size` workers, not started
+    explicit WorkerGroup(std::size_t size)
+        : workers_(size)
+    {}
+
+    /// Destructor, stops workers
+    ~WorkerGroup() noexcept
+    {
+        shutdown();
+    }
+
+    /// Start worker threads, running workers are stopped first
+    /// Body should return periodically (e.g. on poll timeout) to let the worker see stop request.
+    /// The body is copied per worker, a worker stops on exception raised by its body.
+    /// @param[in] cpus is CPUs to pin worker `i` to `cpus[i % cpus.size()]`, empty - no pinning
+    /// @param[in] body is callable `void(std::size_t)`
+    template< class Body >
+    void start(const std::vector< int >& cpus, Body body)
+    {
+        shutdown();
+        stop_.store(false, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+            workers_[i].error = nullptr;
+            workers_[i].thread = std::thread{[this, i, cpu, body]() mutable {
+                run(i, cpu, body);
+            }};
+        }
+    }
+
+    /// Stop and join worker threads
+    /// @throw Rethrow the first exception raised by a worker body
+    void stop()
+    {
+        shutdown();
+        for (auto& worker: workers_) {
+            if (worker.error) {
+                std::rethrow_exception(std::exchange(worker.error, nullptr));
+            }
+        }
+    }
+
+    /// Stop and join worker threads, errors are kept for `stop()`
+    void shutdown() noexcept
+    {
+        stop_.store(true, std::memory_order_relaxed);
+        for (auto& worker: workers_) {
+            if (worker.thread.joinable()) {
+                worker.thread.join();
+            }
+        }
+    }
+
+private:
+    template< class Body >
+    void run(std::size_t index, int cpu, Body& body) noexcept
+    {
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if (int rc = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set); rc != 0) {
+                debug("<WARN> Worker %zu affinity error: %s", index, std::strerror(rc));
+            }
+        }
+
+        try {
+            while (NETBOX_LIKELY(!stop_.load(std::memory_order_relaxed))) {
+                body(index);
+            }
+        } catch (...) {
+            workers_[index].error = std::current_exception();
+        }
+    }
+};
+
+} /* namespace netbox::details */
+
+#endif /* KSERGEY_WorkerGroup_191026113047 */
@@ -0,0 +1,171 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_XdpRing_181026192014
+#define KSERGEY_XdpRing_181026192014
+
+#include <linux/if_xdp.h>
+#include <sys/mman.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <utility>
+
+#include <netbox/exception.h>
+
+namespace netbox::details {
+
+/// Memory mapped AF_XDP ring (fill, completion, RX or TX)
+/// Single producer single consumer ring shared with the kernel, user space
+/// is producer of fill and TX rings and consumer of completion and RX rings.
+/// @tparam Entry is ring entry (`std::uint64_t` UMEM address or `xdp_desc`)
+template< class Entry >
+class XdpRing
+{
+private:
+    void* map_{nullptr};
+    std::size_t mapSize_{0};
+
+    std::uint32_t* producer_{nullptr};
+    std::uint32_t* consumer_{nullptr};
+    std::uint32_t* flags_{nullptr};
+    Entry* entries_{nullptr};
+    std::uint32_t size_{0};
+
+    // Local copies of indices, the shared ones are read only when needed
+    std::uint32_t cachedProducer_{0};
+    std::uint32_t cachedConsumer_{0};
+
+public:
+    XdpRing(const XdpRing&) = delete;
+    XdpRing& operator=(const XdpRing&) = delete;
+
+    /// Move constructor
+    XdpRing(XdpRing&& other) noexcept
+    {
+        swap(other);
+    }
+
+    /// Move operator
+    XdpRing& operator=(XdpRing&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    /// Construct unmapped ring
+    XdpRing() = default;
+
+    /// Map ring of AF_XDP socket
+    /// @param[in] fd is AF_XDP socket
+    /// @param[in] offsets is ring layout (from `XDP_MMAP_OFFSETS`)
+    /// @param[in] size is number of entries (power of two)
+    /// @param[in] pageOffset is ring mmap offset (`XDP_PGOFF_RX_RING`, ...)
+    /// @throw SocketError on error
+    XdpRing(int fd, const xdp_ring_offset& offsets, std::uint32_t size, off_t pageOffset)
+        : mapSize_{offsets.desc + size * sizeof(Entry)}
+        , size_{size}
+    {
+        map_ = ::mmap(nullptr, mapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, pageOffset);
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+            throwEx< SocketError >("mmap", errno);
+        }
+
+        char* base = static_cast< char* >(map_);
+        producer_ = reinterpret_cast< std::uint32_t* >(base + offsets.producer);
+        consumer_ = reinterpret_cast< std::uint32_t* >(base + offsets.consumer);
+        flags_ = reinterpret_cast< std::uint32_t* >(base + offsets.flags);
+        entries_ = reinterpret_cast< Entry* >(base + offsets.desc);
+
+        cachedProducer_ = *producer_;
+        cachedConsumer_ = *consumer_;
+    }
+
+    /// Destructor, unmaps the ring
+    ~XdpRing() noexcept
+    {
+        if (map_) {
+            ::munmap(map_, mapSize_);
+        }
+    }
+
+    /// Return number of ring entries
+    std::uint32_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return entry by free-running index
+    Entry& operator[](std::uint32_t index) noexcept
+    {
+        return entries_[index & (size_ - 1)];
+    }
+
+    /// Return true if the kernel should be woken up by syscall to process the ring
+    bool needWakeup() const noexcept
+    {
+        return __atomic_load_n(flags_, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP;
+    }
+
+    /// Reserve `count` entries to produce
+    /// @param[out] index is index of the first reserved entry
+    /// @return True on success, false if not enough free entries
+    bool reserve(std::uint32_t count, std::uint32_t& index) noexcept
+    {
+        if (size_ - (cachedProducer_ - cachedConsumer_) < count) {
+            cachedConsumer_ = __atomic_load_n(consumer_, __ATOMIC_ACQUIRE);
+            if (size_ - (cachedProducer_ - cachedConsumer_) < count) {
+                return false;
+            }
+        }
+        index = cachedProducer_;
+        cachedProducer_ += count;
+        return true;
+    }
+
+    /// Publish all reserved entries to the kernel
+    void submit() noexcept
+    {
+        __atomic_store_n(producer_, cachedProducer_, __ATOMIC_RELEASE);
+    }
+
+    /// Take up to `count` entries to consume
+    /// @param[out] index is index of the first entry
+    /// @return Number of entries taken
+    std::uint32_t peek(std::uint32_t count, std::uint32_t& index) noexcept
+    {
+        if (cachedProducer_ == cachedConsumer_) {
+            cachedProducer_ = __atomic_load_n(producer_, __ATOMIC_ACQUIRE);
+        }
+        const std::uint32_t result = std::min(count, cachedProducer_ - cachedConsumer_);
+        index = cachedConsumer_;
+        cachedConsumer_ += result;
+        return result;
+    }
+
+    /// Give all taken entries back to the kernel
+    void release() noexcept
+    {
+        __atomic_store_n(consumer_, cachedConsumer_, __ATOMIC_RELEASE);
+    }
+
+private:
+    void swap(XdpRing& other) noexcept
+    {
+        std::swap(map_, other.map_);
+        std::swap(mapSize_, other.mapSize_);
+        std::swap(producer_, other.producer_);
+        std::swap(consumer_, other.consumer_);
+        std::swap(flags_, other.flags_);
+        std::swap(entries_, other.entries_);
+        std::swap(size_, other.size_);
+        std::swap(cachedProducer_, other.cachedProducer_);
+        std::swap(cachedConsumer_, other.cachedConsumer_);
+    }
+};
+
+} /* namespace netbox::details */
+
+#endif /* KSERGEY_XdpRing_181026192014 */
@@ -0,0 +1,165 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_bpf_181026191240
+#define KSERGEY_bpf_181026191240
+
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <netbox/exception.h>
+
+namespace netbox::details {
+
+/// Owned BPF object descriptor (map, program or link)
+class BpfObject
+{
+private:
+    int fd_{-1};
+
+public:
+    BpfObject(const BpfObject&) = delete;
+    BpfObject& operator=(const BpfObject&) = delete;
+
+    /// Move constructor
+    BpfObject(BpfObject&& other) noexcept
+        : fd_{std::exchange(other.fd_, -1)}
+    {}
+
+    /// Move operator
+    BpfObject& operator=(BpfObject&& other) noexcept
+    {
+        std::swap(fd_, other.fd_);
+        return *this;
+    }
+
+    /// Construct empty object
+    BpfObject() = default;
+
+    /// Take ownership of descriptor
+    explicit BpfObject(int fd) noexcept
+        : fd_{fd}
+    {}
+
+    /// Destructor, the object is released by kernel with the last reference
+    ~BpfObject() noexcept
+    {
+        if (fd_ != -1) {
+            ::close(fd_);
+        }
+    }
+
+    /// Return true if object present
+    explicit operator bool() const noexcept
+    {
+        return fd_ != -1;
+    }
+
+    /// Return native descriptor
+    int native() const noexcept
+    {
+        return fd_;
+    }
+};
+
+/// Invoke bpf() syscall
+inline int bpf(int cmd, bpf_attr& attr) noexcept
+{
+    return ::syscall(__NR_bpf, cmd, &attr, sizeof(attr));
+}
+
+/// Create XSKMAP (queue index to AF_XDP socket)
+/// @throw SocketError on error
+inline BpfObject createXskMap(std::uint32_t entries)
+{
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(std::uint32_t);
+    attr.value_size = sizeof(std::uint32_t);
+    attr.max_entries = entries;
+    const int fd = bpf(BPF_MAP_CREATE, attr);
+    if (fd == -1) {
+        throwEx< SocketError >("bpf(BPF_MAP_CREATE)", errno);
+    }
+    return BpfObject{fd};
+}
+
+/// Set map element
+/// @throw SocketError on error
+inline void updateMap(const BpfObject& map, std::uint32_t key, std::uint32_t value)
+{
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.map_fd = map.native();
+    attr.key = reinterpret_cast< std::uintptr_t >(&key);
+    attr.value = reinterpret_cast< std::uintptr_t >(&value);
+    attr.flags = BPF_ANY;
+    if (bpf(BPF_MAP_UPDATE_ELEM, attr) != 0) {
+        throwEx< SocketError >("bpf(BPF_MAP_UPDATE_ELEM)", errno);
+    }
+}
+
+/// Load XDP program redirecting packets of receive queue `i` to AF_XDP socket `map[i]`,
+/// packets of queues without socket pass to the network stack
+/// @throw SocketError on error
+inline BpfObject loadXskRedirectProgram(const BpfObject& map)
+{
+    const bpf_insn program[] = {
+        // r2 = ctx->rx_queue_index
+        {BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_1, std::int16_t(offsetof(xdp_md, rx_queue_index)), 0},
+        // r1 = map
+        {BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, map.native()},
+        {0, 0, 0, 0, 0},
+        // r3 = XDP_PASS (action if no socket in map)
+        {BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS},
+        // r0 = bpf_redirect_map(r1, r2, r3)
+        {BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map},
+        // return r0
+        {BPF_JMP | BPF_EXIT, 0, 0, 0, 0}
+    };
+    static constexpr char License[] = "Dual BSD/GPL";
+
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = reinterpret_cast< std::uintptr_t >(program);
+    attr.insn_cnt = sizeof(program) / sizeof(program[0]);
+    attr.license = reinterpret_cast< std::uintptr_t >(License);
+    const int fd = bpf(BPF_PROG_LOAD, attr);
+    if (fd == -1) {
+        throwEx< SocketError >("bpf(BPF_PROG_LOAD)", errno);
+    }
+    return BpfObject{fd};
+}
+
+/// Attach XDP program to interface, the program is detached when the link released
+/// @param[in] program is XDP program
+/// @param[in] ifindex is interface index
+/// @param[in] flags is attach mode (`XDP_FLAGS_SKB_MODE`, `XDP_FLAGS_DRV_MODE`)
+/// @throw SocketError on error
+inline BpfObject attachXdp(const BpfObject& program, int ifindex, std::uint32_t flags)
+{
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.link_create.prog_fd = program.native();
+    attr.link_create.target_ifindex = ifindex;
+    attr.link_create.attach_type = BPF_XDP;
+    attr.link_create.flags = flags;
+    const int fd = bpf(BPF_LINK_CREATE, attr);
+    if (fd == -1) {
+        throwEx< SocketError >("bpf(BPF_LINK_CREATE)", errno);
+    }
+    return BpfObject{fd};
+}
+
+} /* namespace netbox::details */
+
+#endif /* KSERGEY_bpf_181026191240 */
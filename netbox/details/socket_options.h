@@ -5,11 +5,15 @@
 #ifndef KSERGEY_socket_options_160918004441
 #define KSERGEY_socket_options_160918004441
 
+#include <linux/filter.h>
 #include <linux/if_packet.h>
+#include <linux/if_xdp.h>
 #include <linux/if_ether.h>
 #include <linux/net_tstamp.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <cstddef>
+#include <cstring>
 
 #include <netbox/IPv4.h>
 #include <netbox/IPv6.h>
@@ -227,7 +231,10 @@ public:
     }
 };
 
-template< int Level, int Name, class Struct >
+/// Socket option struct type
+/// @tparam MinSize is minimal size of struct returned by kernel, the kernel
+///     of older version may return struct without the trailing fields
+template< int Level, int Name, class Struct, std::size_t MinSize = sizeof(Struct) >
 class StructOption
 {
 private:
@@ -243,6 +250,11 @@ public:
         : value_{std::forward< Args >(args)...}
     {}
 
+    constexpr const Struct& value() const noexcept
+    {
+        return value_;
+    }
+
     constexpr int level() const noexcept
     {
         return Level;
@@ -253,6 +265,11 @@ public:
         return Name;
     }
 
+    constexpr void* data() noexcept
+    {
+        return &value_;
+    }
+
     constexpr const void* data() const noexcept
     {
         return &value_;
@@ -262,6 +279,17 @@ public:
     {
         return sizeof(value_);
     }
+
+    constexpr void resize(std::size_t size)
+    {
+        if (size < MinSize || size > sizeof(value_)) {
+            throwEx< SocketOptionError >("Struct socket option error");
+        }
+        if (size < sizeof(value_)) {
+            // Fields not returned are zeroed
+            std::memset(reinterpret_cast< char* >(&value_) + size, 0, sizeof(value_) - size);
+        }
+    }
 };
 
 } // namespace  netbox::details
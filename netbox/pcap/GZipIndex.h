@@ -0,0 +1,249 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_GZipIndex_181026104455
+#define KSERGEY_GZipIndex_181026104455
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <zlib.h>
+
+#include <netbox/debug.h>
+#include <netbox/pcap/pcap.h>
+#include <netbox/pcap/Sidecar.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/FileChunkProducer.h>
+#include <netbox/utils/GZipDecompressStream.h>
+
+namespace netbox::pcap {
+
+/// Random access index of GZip compressed PCAP file (zran-style)
+/// Holds inflate checkpoints at deflate block boundaries every `span` bytes
+/// of decompressed data, each mapped to the first PCAP record after it.
+class GZipIndex
+{
+public:
+    /// Default distance between checkpoints (of decompressed data)
+    static constexpr std::size_t DefaultSpan = 8 * 1024 * 1024;
+
+    /// Size of inflate dictionary
+    static constexpr std::size_t WindowSize = 32768;
+
+    /// Inflate checkpoint
+    struct Checkpoint
+    {
+        /// Offset of the first compressed byte after the block boundary
+        std::uint64_t input;
+        /// Offset of decompressed data at the block boundary
+        std::uint64_t output;
+        /// Offset of decompressed data of the first PCAP record after boundary
+        std::uint64_t record;
+        /// Timestamp of the record (nanoseconds since Epoch)
+        std::uint64_t timestamp;
+        /// Number of bits of byte at `input - 1` belongs to the block
+        std::uint8_t bits;
+        /// Decompressed data preceding the block boundary
+        std::uint8_t window[WindowSize];
+    };
+
+private:
+    static constexpr char Magic[8] = {'N', 'B', 'G', 'Z', 'I', 'D', 'X', '1'};
+    static constexpr std::size_t InputSize = 256 * 1024;
+    static constexpr std::size_t OutputSize = 8 * WindowSize;
+
+    std::vector< Checkpoint > checkpoints_;
+
+public:
+    GZipIndex() = default;
+
+    /// Return number of checkpoints
+    std::size_t size() const noexcept
+    {
+        return checkpoints_.size();
+    }
+
+    /// Return true if no checkpoints
+    bool empty() const noexcept
+    {
+        return checkpoints_.empty();
+    }
+
+    /// Return checkpoint by index
+    const Checkpoint& operator[](std::size_t index) const noexcept
+    {
+        return checkpoints_[index];
+    }
+
+    /// Find the last checkpoint with record timestamp less than `unixTimeNs`
+    /// @return Checkpoint or `nullptr` if the file should be read from the beginning
+    /// @pre PCAP records are ordered by time
+    const Checkpoint* find(std::uint64_t unixTimeNs) const noexcept
+    {
+        auto found = std::lower_bound(checkpoints_.begin(), checkpoints_.end(), unixTimeNs,
+                [](const Checkpoint& checkpoint, std::uint64_t value) {
+                    return checkpoint.timestamp < value;
+                });
+        if (found == checkpoints_.begin()) {
+            return nullptr;
+        }
+        return &*(found - 1);
+    }
+
+    /// Build index scanning whole file
+    /// @param[in] filename is path to GZip compressed PCAP file
+    /// @param[in] span is distance between checkpoints
+    /// @return Index, empty on error
+    static GZipIndex build(const char* filename, std::size_t span = DefaultSpan)
+    {
+        GZipIndex index;
+
+        utils::FileChunkProducer file{filename};
+        if (!file) {
+            return index;
+        }
+
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        if (inflateInit2(&stream, MAX_WBITS | 16) != Z_OK) {
+            return index;
+        }
+        std::unique_ptr< z_stream, int (*)(z_stream*) > guard{&stream, inflateEnd};
+
+        utils::Arena input{InputSize};
+        utils::Arena output{OutputSize};
+        std::size_t outputUsed = 0;
+
+        // Counters of compressed and decompressed data
+        std::uint64_t totalIn = 0;
+        std::uint64_t totalOut = 0;
+        std::uint64_t last = 0;
+
+        // PCAP parser state
+        TimestampScale scale{TimestampScale::PassThrough};
+        bool headerParsed = false;
+        std::uint64_t nextRecord = sizeof(FileHeader);
+        std::unique_ptr< Checkpoint > pending;
+
+        while (true) {
+            if (stream.avail_in == 0) {
+                stream.avail_in = file.produce(input.data(), input.size());
+                stream.next_in = reinterpret_cast< Bytef* >(input.data());
+                if (stream.avail_in == 0) {
+                    break;
+                }
+            }
+
+            if (outputUsed == output.size()) {
+                // Keep the last window for the next checkpoint
+                std::memmove(output.data(), output.data() + outputUsed - WindowSize, WindowSize);
+                outputUsed = WindowSize;
+            }
+
+            stream.next_out = reinterpret_cast< Bytef* >(output.data() + outputUsed);
+            stream.avail_out = output.size() - outputUsed;
+
+            totalIn += stream.avail_in;
+            totalOut += stream.avail_out;
+            outputUsed += stream.avail_out;
+            const int result = inflate(&stream, Z_BLOCK);
+            totalIn -= stream.avail_in;
+            totalOut -= stream.avail_out;
+            outputUsed -= stream.avail_out;
+
+            if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+                debug("<WARN> GZip index build error (%s)", filename);
+                return {};
+            }
+
+            // Walk PCAP records decompressed so far
+            const std::uint64_t base = totalOut - outputUsed;
+            if (!headerParsed && totalOut >= sizeof(FileHeader)) {
+                FileHeader header;
+                std::memcpy(&header, output.data(), sizeof(header));
+                if (base != 0 || !checkFileHeader(header, scale)) {
+                    return {};
+                }
+                headerParsed = true;
+            }
+            while (headerParsed && nextRecord + sizeof(PacketHeader) <= totalOut) {
+                PacketHeader header;
+                std::memcpy(&header, output.data() + (nextRecord - base), sizeof(header));
+                scaleTimestamp(header, scale);
+                if (pending && nextRecord >= pending->output) {
+                    pending->record = nextRecord;
+                    pending->timestamp = header.ts_sec * 1000000000ull + header.ts_usec;
+                    index.checkpoints_.push_back(*pending);
+                    pending.reset();
+                }
+                nextRecord += sizeof(header) + header.caplen;
+            }
+
+            if (result == Z_STREAM_END) {
+                // Next GZip member expected, anything else is trailing garbage
+                if (stream.avail_in == 0) {
+                    stream.avail_in = file.produce(input.data(), input.size());
+                    stream.next_in = reinterpret_cast< Bytef* >(input.data());
+                }
+                if (stream.avail_in == 0 || stream.next_in[0] != 0x1f) {
+                    break;
+                }
+                inflateReset(&stream);
+                continue;
+            }
+
+            // Block boundary (not after the last block) far enough from the previous one
+            if ((stream.data_type & 128) && !(stream.data_type & 64)
+                    && !pending && totalOut - last >= span && outputUsed >= WindowSize) {
+                pending = std::make_unique< Checkpoint >();
+                pending->input = totalIn;
+                pending->output = totalOut;
+                pending->bits = stream.data_type & 7;
+                std::memcpy(pending->window, output.data() + outputUsed - WindowSize, WindowSize);
+                last = totalOut;
+            }
+        }
+
+        return index;
+    }
+
+    /// Create decompressor of the file resumed at checkpoint
+    /// @param[in] filename is path to GZip compressed PCAP file
+    /// @param[in] checkpoint is position to resume from
+    /// @param[in] direct is true to bypass page cache (O_DIRECT)
+    /// @return Producer of data decompressed from `checkpoint.output` offset
+    static std::unique_ptr< utils::ChunkProducer > open(const char* filename,
+            const Checkpoint& checkpoint, bool direct = false)
+    {
+        auto file = std::make_unique< utils::FileChunkProducer >(filename, direct);
+        if (!*file || !file->seek(checkpoint.input - (checkpoint.bits ? 1 : 0))) {
+            return nullptr;
+        }
+        return std::make_unique< utils::GZipDecompressStream >(std::move(file),
+                checkpoint.bits, checkpoint.window, WindowSize);
+    }
+
+    /// Load index from sidecar file
+    /// @param[in] path is path to sidecar file
+    /// @param[in] filename is path to indexed file, index is rejected if file modified
+    /// @return True on success
+    bool load(const char* path, const char* filename)
+    {
+        return Sidecar::load(path, filename, Magic, checkpoints_);
+    }
+
+    /// Save index into sidecar file
+    /// @param[in] path is path to sidecar file
+    /// @param[in] filename is path to indexed file
+    /// @return True on success
+    bool save(const char* path, const char* filename) const
+    {
+        return Sidecar::save(path, filename, Magic, checkpoints_);
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_GZipIndex_181026104455 */
@@ -0,0 +1,187 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_MappedReader_171026102204
+#define KSERGEY_MappedReader_171026102204
+
+#include <cstring>
+#include <vector>
+
+#include <netbox/buffer.h>
+#include <netbox/debug.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/utils/MappedFile.h>
+
+namespace netbox::pcap {
+
+/// Single file PCAP reader over memory mapped (or in-memory) data
+/// Packets point straight into the mapping, no data copied.
+/// Compressed files are not supported.
+class MappedReader
+{
+private:
+    /// Size of the window prefetched ahead of the read position
+    static constexpr std::size_t ReadaheadSize = 8 * 1024 * 1024;
+
+    utils::MappedFile file_;
+    const char* begin_{nullptr};
+    const char* cursor_{nullptr};
+    const char* end_{nullptr};
+    // Position of the next readahead request (mapped files only)
+    const char* readahead_{nullptr};
+    TimestampScale scale_{TimestampScale::PassThrough};
+    int timezone_{0};
+    std::uint32_t snaplen_{0};
+    bool good_{false};
+    bool eof_{false};
+    std::vector< Packet > batch_;
+
+public:
+    MappedReader(const MappedReader&) = delete;
+    MappedReader& operator=(const MappedReader&) = delete;
+
+    /// Construct reader
+    /// @param[in] filename is path to uncompressed PCAP file
+    MappedReader(const char* filename)
+        : file_{filename}
+    {
+        if (file_) {
+            file_.advise(0, file_.size(), MADV_SEQUENTIAL);
+            open(file_.buffer());
+            if (good_) {
+                readahead_ = cursor_;
+            }
+        }
+    }
+
+    /// Construct reader over PCAP file content in memory
+    /// @param[in] buffer is PCAP file content, should outlive reader
+    MappedReader(ConstBuffer buffer)
+    {
+        open(buffer);
+    }
+
+    /// Return true if file valid
+    explicit operator bool() const noexcept
+    {
+        return good_;
+    }
+
+    /// Return true if reader good
+    bool good() const noexcept
+    {
+        return good_ && !eof_;
+    }
+
+    /// Return true if end of file reached
+    bool eof() const noexcept
+    {
+        return eof_;
+    }
+
+    /// Read packet
+    /// The returned packet is available while reader alive
+    Packet readPacket()
+    {
+        PacketHeader header;
+
+        if (NETBOX_UNLIKELY(std::size_t(end_ - cursor_) < sizeof(header))) {
+            if (cursor_ != end_) {
+                debug("<WARN> Header read %u of %u", unsigned(end_ - cursor_), sizeof(header));
+            }
+            return (cursor_ = end_), (eof_ = true), Packet{};
+        }
+
+        // Record headers are not aligned inside file
+        std::memcpy(&header, cursor_, sizeof(header));
+        scaleTimestamp(header, scale_);
+
+        if (header.caplen > snaplen_) {
+            debug("<WARN> PCAP packet header caplen(%u) greater snaplen", header.caplen);
+            return (good_ = false), (eof_ = true), Packet{};
+        }
+
+        const char* data = cursor_ + sizeof(header);
+        if (NETBOX_UNLIKELY(std::size_t(end_ - data) < header.caplen)) {
+            debug("<WARN> Data read %u of %u", unsigned(end_ - data), header.caplen);
+            return (cursor_ = end_), (eof_ = true), Packet{};
+        }
+
+        cursor_ = data + header.caplen;
+
+        if (NETBOX_UNLIKELY(readahead_ && cursor_ >= readahead_)) {
+            prefetch();
+        }
+
+        return {header, data};
+    }
+
+    /// Read up to `count` packets
+    /// @return Number of packets read, less than `count` only if no more packets
+    std::size_t readPackets(Packet* packets, std::size_t count)
+    {
+        std::size_t result = 0;
+        while (result < count) {
+            auto packet = readPacket();
+            if (NETBOX_UNLIKELY(!packet)) {
+                break;
+            }
+            packets[result++] = packet;
+        }
+        return result;
+    }
+
+    /// Read batch of up to `count` packets
+    /// The batch will be available until next call `readBatch()`,
+    /// packets itself are available while reader alive
+    PacketBatch readBatch(std::size_t count)
+    {
+        if (batch_.size() < count) {
+            batch_.resize(count);
+        }
+        return {batch_.data(), readPackets(batch_.data(), count)};
+    }
+
+private:
+    void open(ConstBuffer buffer)
+    {
+        begin_ = bufferCast< const char* >(buffer);
+        end_ = begin_ + bufferSize(buffer);
+        // Nothing to read until header validated
+        cursor_ = end_;
+
+        FileHeader header;
+
+        if (bufferSize(buffer) < sizeof(header)) {
+            return debug("<WARN> Read PCAP header error");
+        }
+
+        std::memcpy(&header, begin_, sizeof(header));
+        if (!checkFileHeader(header, scale_)) {
+            return;
+        }
+
+        cursor_ = begin_ + sizeof(header);
+        timezone_ = header.thiszone;
+        snaplen_ = header.snaplen;
+        good_ = true;
+    }
+
+    void prefetch() noexcept
+    {
+        const std::size_t offset = readahead_ - begin_;
+        if (!file_.advise(offset, ReadaheadSize, MADV_WILLNEED)) {
+            readahead_ = nullptr;
+            return;
+        }
+        readahead_ = std::size_t(end_ - readahead_) > ReadaheadSize
+            ? readahead_ + ReadaheadSize
+            : nullptr;
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_MappedReader_171026102204 */
@@ -8,7 +8,18 @@
 #include <ctime>
 #include <netbox/pcap/pcap.h>
 
-namespace netbox::pcap {
+namespace netbox {
+namespace details {
+
+/// Convert `timespec` to nanoseconds since Epoch
+constexpr std::uint64_t makeUnixTimeNs(const timespec& ts) noexcept
+{
+    return ts.tv_sec * 1000000000ul + ts.tv_nsec;
+}
+
+} /* namespace details */
+
+namespace pcap {
 
 /// PCAP packet
 class Packet
@@ -30,6 +41,15 @@ public:
         , data_{data}
     {}
 
+    /// Construct packet from attributes and packet data
+    constexpr Packet(const timespec& timestamp, std::uint32_t captureLength,
+            std::uint32_t length, const void* data)
+        : timestamp_{timestamp}
+        , captureLength_{captureLength}
+        , length_{length}
+        , data_{data}
+    {}
+
     /// Return true data present
     constexpr explicit operator bool() const noexcept
     {
@@ -60,6 +80,7 @@ public:
     }
 };
 
-} /* namespace netbox::pcap */
+} /* namespace pcap */
+} /* namespace netbox */
 
 #endif /* KSERGEY_Packet_160918003832 */
@@ -0,0 +1,59 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_PacketBatch_171026112310
+#define KSERGEY_PacketBatch_171026112310
+
+#include <cstddef>
+
+#include <netbox/pcap/Packet.h>
+
+namespace netbox::pcap {
+
+/// View over a batch of packets
+class PacketBatch
+{
+private:
+    const Packet* data_{nullptr};
+    std::size_t size_{0};
+
+public:
+    constexpr PacketBatch() = default;
+
+    constexpr PacketBatch(const Packet* data, std::size_t size) noexcept
+        : data_{data}
+        , size_{size}
+    {}
+
+    /// Return number of packets in batch
+    constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return true if batch has no packets
+    constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    constexpr const Packet& operator[](std::size_t index) const noexcept
+    {
+        return data_[index];
+    }
+
+    constexpr const Packet* begin() const noexcept
+    {
+        return data_;
+    }
+
+    constexpr const Packet* end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_PacketBatch_171026112310 */
@@ -0,0 +1,274 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_PacketPool_181026151037
+#define KSERGEY_PacketPool_181026151037
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/utils/Arena.h>
+
+namespace netbox::pcap {
+
+class PooledPacket;
+
+/// Pool of reference counted packet buffers
+/// Buffers are carved from slabs of `slabSize` bytes, each holds a packet of
+/// up to `slotSize` bytes, bigger packets get dedicated buffers.
+/// Packets are allocated by the thread owning the pool, the returned `PooledPacket`
+/// could be retained, passed to and released by any thread. Released buffers
+/// go back to the pool through a lock-free list. Buffers stay valid after
+/// the pool destroyed until released.
+class PacketPool
+{
+    friend class PooledPacket;
+
+public:
+    /// Default data capacity of buffer, fits Ethernet frame
+    static constexpr std::size_t DefaultSlotSize = 2048;
+
+    /// Default size of slab of buffers
+    static constexpr std::size_t DefaultSlabSize = 1024 * 1024;
+
+private:
+    struct State;
+
+    // Buffer header, followed by packet data
+    struct alignas(NETBOX_CACHE_LINE_SIZE) Slot
+    {
+        std::atomic< std::uint32_t > refs{0};
+        // Dedicated buffer of oversized packet
+        bool dedicated{false};
+        State* state{nullptr};
+        Slot* next{nullptr};
+        Packet packet;
+
+        char* data() noexcept
+        {
+            return reinterpret_cast< char* >(this + 1);
+        }
+    };
+
+    // Shared by pool and allocated buffers
+    struct State
+    {
+        // Buffers released by any thread
+        std::atomic< Slot* > released{nullptr};
+        // Pool reference plus one per allocated buffer
+        std::atomic< std::size_t > refs{1};
+        // Free buffers private to the owner thread
+        Slot* free{nullptr};
+        std::vector< utils::Arena > slabs;
+        std::size_t slotSize{0};
+        std::size_t slabSize{0};
+    };
+
+    State* state_{nullptr};
+
+public:
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    /// Construct pool, no memory allocated until first packet
+    /// @param[in] slotSize is data capacity of buffer
+    /// @param[in] slabSize is size of slab of buffers
+    explicit PacketPool(std::size_t slotSize = DefaultSlotSize, std::size_t slabSize = DefaultSlabSize)
+        : state_{new State}
+    {
+        state_->slotSize = sizeof(Slot) + align(std::max< std::size_t >(slotSize, 1));
+        state_->slabSize = std::max(slabSize, state_->slotSize);
+    }
+
+    /// Destructor, buffers in use stay valid
+    ~PacketPool() noexcept
+    {
+        unref(state_);
+    }
+
+    /// Copy packet into pooled buffer
+    /// @param[in] packet is packet to copy
+    /// @return Pooled packet, empty if `packet` empty
+    /// @throw std::bad_alloc if allocation failed
+    PooledPacket copy(const Packet& packet);
+
+private:
+    static constexpr std::size_t align(std::size_t size) noexcept
+    {
+        return (size + alignof(Slot) - 1) & ~(alignof(Slot) - 1);
+    }
+
+    static void unref(State* state) noexcept
+    {
+        if (state->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete state;
+        }
+    }
+
+    /// Return buffer to its pool, called by the last reference holder
+    static void release(Slot* slot) noexcept
+    {
+        State* state = slot->state;
+        if (NETBOX_UNLIKELY(slot->dedicated)) {
+            slot->~Slot();
+            std::free(slot);
+        } else {
+            Slot* head = state->released.load(std::memory_order_relaxed);
+            do {
+                slot->next = head;
+            } while (!state->released.compare_exchange_weak(head, slot,
+                        std::memory_order_release, std::memory_order_relaxed));
+        }
+        unref(state);
+    }
+
+    Slot* allocate(std::size_t size)
+    {
+        Slot* slot;
+        if (NETBOX_UNLIKELY(sizeof(Slot) + size > state_->slotSize)) {
+            void* memory = std::aligned_alloc(alignof(Slot), sizeof(Slot) + align(size));
+            if (!memory) {
+                throw std::bad_alloc{};
+            }
+            slot = new (memory) Slot;
+            slot->dedicated = true;
+        } else {
+            if (NETBOX_UNLIKELY(!state_->free)) {
+                // Take all released buffers at once
+                state_->free = state_->released.exchange(nullptr, std::memory_order_acquire);
+                if (!state_->free) {
+                    grow();
+                }
+            }
+            slot = state_->free;
+            state_->free = slot->next;
+        }
+
+        slot->state = state_;
+        slot->refs.store(1, std::memory_order_relaxed);
+        state_->refs.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    void grow()
+    {
+        utils::Arena slab{state_->slabSize};
+        const std::size_t count = slab.size() / state_->slotSize;
+        for (std::size_t i = 0; i < count; ++i) {
+            Slot* slot = new (slab.data() + i * state_->slotSize) Slot;
+            slot->next = state_->free;
+            state_->free = slot;
+        }
+        state_->slabs.push_back(std::move(slab));
+    }
+};
+
+/// Reference counted handle of packet inside `PacketPool` buffer
+/// Copying the handle retains the buffer, the buffer is released with the last handle.
+class PooledPacket
+{
+    friend class PacketPool;
+
+private:
+    PacketPool::Slot* slot_{nullptr};
+
+    explicit PooledPacket(PacketPool::Slot* slot) noexcept
+        : slot_{slot}
+    {}
+
+public:
+    /// Construct empty handle
+    PooledPacket() = default;
+
+    /// Copy constructor, retains buffer
+    PooledPacket(const PooledPacket& other) noexcept
+        : slot_{other.slot_}
+    {
+        if (slot_) {
+            slot_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Copy operator, retains buffer
+    PooledPacket& operator=(const PooledPacket& other) noexcept
+    {
+        PooledPacket{other}.swap(*this);
+        return *this;
+    }
+
+    /// Move constructor
+    PooledPacket(PooledPacket&& other) noexcept
+        : slot_{std::exchange(other.slot_, nullptr)}
+    {}
+
+    /// Move operator
+    PooledPacket& operator=(PooledPacket&& other) noexcept
+    {
+        PooledPacket{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    /// Destructor, releases buffer
+    ~PooledPacket() noexcept
+    {
+        if (slot_ && slot_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            PacketPool::release(slot_);
+        }
+    }
+
+    /// Return true if packet present
+    explicit operator bool() const noexcept
+    {
+        return slot_ != nullptr;
+    }
+
+    /// Return packet, data points into the pooled buffer
+    /// @pre `*this`
+    const Packet& operator*() const noexcept
+    {
+        return slot_->packet;
+    }
+
+    /// Access packet
+    /// @pre `*this`
+    const Packet* operator->() const noexcept
+    {
+        return &slot_->packet;
+    }
+
+    /// Return packet or empty packet if no packet present
+    Packet get() const noexcept
+    {
+        return slot_ ? slot_->packet : Packet{};
+    }
+
+    /// Swap handles
+    void swap(PooledPacket& other) noexcept
+    {
+        std::swap(slot_, other.slot_);
+    }
+};
+
+inline PooledPacket PacketPool::copy(const Packet& packet)
+{
+    if (NETBOX_UNLIKELY(!packet)) {
+        return {};
+    }
+
+    Slot* slot = allocate(packet.captureLength());
+    std::memcpy(slot->data(), packet.data(), packet.captureLength());
+    slot->packet = Packet{packet.timestamp(), packet.captureLength(), packet.length(), slot->data()};
+    return PooledPacket{slot};
+}
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_PacketPool_181026151037 */
@@ -0,0 +1,362 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Prefetcher_181026142210
+#define KSERGEY_Prefetcher_181026142210
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/Reader.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/SpscRing.h>
+
+namespace netbox::pcap {
+
+/// Read PCAP files on a pool of worker threads
+/// Workers copy packets of each file into blocks and pass filled blocks
+/// to the consumer through a lock-free ring. Each file owns a fixed number
+/// of blocks, so a file far ahead of the consumer stalls until blocks are released.
+class Prefetcher
+{
+private:
+    // Packet record inside block, followed by packet data
+    struct Record
+    {
+        timespec timestamp;
+        std::uint32_t captureLength;
+        std::uint32_t length;
+    };
+
+    static constexpr std::size_t RecordAlignment = alignof(Record);
+
+    struct Block
+    {
+        utils::Arena data;
+        std::size_t size{0};
+    };
+
+    struct Channel
+    {
+        std::unique_ptr< Reader > reader;
+        std::vector< Block > blocks;
+        // Blocks filled by worker
+        utils::SpscRing< Block* > filled;
+        // Blocks released by consumer
+        utils::SpscRing< Block* > free;
+        // Packet read but not fit into previous block
+        Packet pending;
+
+        // Guarded by Prefetcher::mutex_
+        bool busy{false};
+        bool finished{false};
+        std::exception_ptr error;
+
+        // Consumer state
+        Block* current{nullptr};
+        const char* cursor{nullptr};
+        const char* end{nullptr};
+
+        Channel(std::unique_ptr< Reader > r, std::size_t blockCount, std::size_t blockSize)
+            : reader{std::move(r)}
+            , blocks(blockCount)
+            , filled{blockCount}
+            , free{blockCount}
+        {
+            for (auto& block: blocks) {
+                block.data.reserve(blockSize);
+                free.tryPush(&block);
+            }
+        }
+    };
+
+    std::vector< std::unique_ptr< Channel > > channels_;
+    std::size_t blockSize_;
+    std::size_t blockCount_;
+
+    std::mutex mutex_;
+    // Notify workers about released blocks
+    std::condition_variable workCondition_;
+    // Notify consumer about filled blocks
+    std::condition_variable dataCondition_;
+    // Number of workers waiting for released blocks
+    std::atomic< unsigned > idle_{0};
+    // Channel to look for work first
+    std::size_t cursor_{0};
+    bool stop_{false};
+
+    std::vector< std::thread > threads_;
+
+public:
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    /// Start worker threads
+    /// @param[in] threads is number of worker threads
+    /// @param[in] blockSize is size of block of packets
+    /// @param[in] blockCount is number of blocks per file
+    Prefetcher(unsigned threads, std::size_t blockSize, std::size_t blockCount)
+        : blockSize_{std::max(blockSize, sizeof(Record) + MaxSnapLen + RecordAlignment)}
+        , blockCount_{std::max< std::size_t >(blockCount, 2)}
+    {
+        threads = std::max(threads, 1u);
+        threads_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] { run(); });
+        }
+    }
+
+    /// Stop worker threads
+    ~Prefetcher() noexcept
+    {
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            stop_ = true;
+        }
+        workCondition_.notify_all();
+        for (auto& thread: threads_) {
+            thread.join();
+        }
+    }
+
+    /// Start prefetching of file
+    /// @param[in] reader is opened file reader
+    /// @return Index of file
+    std::size_t add(std::unique_ptr< Reader > reader)
+    {
+        auto channel = std::make_unique< Channel >(std::move(reader), blockCount_, blockSize_);
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            channels_.push_back(std::move(channel));
+        }
+        workCondition_.notify_one();
+        return channels_.size() - 1;
+    }
+
+    /// Read packet of file
+    /// Waits for worker if no packets prefetched yet.
+    /// The returned packet is available until next call `readPacket()` for the same file
+    /// @param[in] index is index of file
+    /// @throw Rethrow exception raised by file reader
+    Packet readPacket(std::size_t index)
+    {
+        Channel& channel = *channels_[index];
+
+        if (NETBOX_UNLIKELY(channel.cursor == channel.end) && !acquire(channel)) {
+            return {};
+        }
+
+        Record record;
+        std::memcpy(&record, channel.cursor, sizeof(record));
+        const char* data = channel.cursor + sizeof(record);
+        channel.cursor = data + align(record.captureLength);
+        return {record.timestamp, record.captureLength, record.length, data};
+    }
+
+    /// Position file at the first packet with timestamp not less than `unixTimeNs`
+    /// Prefetched packets of the file are dropped.
+    /// @param[in] index is index of file
+    /// @return True if such packet found
+    /// @throw Rethrow exception raised by file reader
+    /// @see Reader::seek()
+    bool seek(std::size_t index, std::uint64_t unixTimeNs)
+    {
+        Channel& channel = *channels_[index];
+
+        // Take file from workers
+        {
+            std::unique_lock< std::mutex > lock{mutex_};
+            dataCondition_.wait(lock, [&channel] { return !channel.busy; });
+            channel.busy = true;
+        }
+
+        // Return all blocks to the free ring
+        if (channel.current) {
+            channel.free.tryPush(channel.current);
+            channel.current = nullptr;
+        }
+        Block* block = nullptr;
+        while (channel.filled.tryPop(block)) {
+            channel.free.tryPush(block);
+        }
+        channel.cursor = channel.end = nullptr;
+        channel.pending = {};
+
+        bool found = false;
+        std::exception_ptr error;
+        try {
+            found = channel.reader->seek(unixTimeNs);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            channel.busy = false;
+            channel.finished = !found;
+            channel.error = nullptr;
+        }
+        workCondition_.notify_all();
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return found;
+    }
+
+private:
+    static constexpr std::size_t align(std::size_t size) noexcept
+    {
+        return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+    }
+
+    /// Release consumed block and wait for the next one
+    bool acquire(Channel& channel)
+    {
+        if (channel.current) {
+            channel.free.tryPush(channel.current);
+            channel.current = nullptr;
+            // Pairs with fence in run()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (idle_.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard< std::mutex > lock{mutex_};
+                workCondition_.notify_one();
+            }
+        }
+
+        Block* block = nullptr;
+        while (true) {
+            if (channel.filled.tryPop(block)) {
+                if (NETBOX_LIKELY(block->size > 0)) {
+                    break;
+                }
+                // The last block of file could be empty
+                channel.free.tryPush(block);
+                continue;
+            }
+
+            std::unique_lock< std::mutex > lock{mutex_};
+            dataCondition_.wait(lock, [&channel] {
+                return !channel.filled.empty() || channel.finished;
+            });
+            if (channel.filled.empty()) {
+                if (channel.error) {
+                    std::rethrow_exception(std::exchange(channel.error, nullptr));
+                }
+                return false;
+            }
+        }
+
+        channel.current = block;
+        channel.cursor = block->data.data();
+        channel.end = channel.cursor + block->size;
+        return true;
+    }
+
+    /// Find channel with free block, called under `mutex_`
+    Channel* findWork(Block*& block) noexcept
+    {
+        for (std::size_t i = 0; i < channels_.size(); ++i) {
+            Channel& channel = *channels_[(cursor_ + i) % channels_.size()];
+            if (!channel.busy && !channel.finished && channel.free.tryPop(block)) {
+                cursor_ = (cursor_ + i + 1) % channels_.size();
+                return &channel;
+            }
+        }
+        return nullptr;
+    }
+
+    void run() noexcept
+    {
+        while (true) {
+            Channel* channel = nullptr;
+            Block* block = nullptr;
+            {
+                std::unique_lock< std::mutex > lock{mutex_};
+                while (!stop_ && !(channel = findWork(block))) {
+                    idle_.fetch_add(1, std::memory_order_relaxed);
+                    // Pairs with fence in acquire(), either we see the released block
+                    // or the consumer sees us idle
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    channel = findWork(block);
+                    if (!channel) {
+                        workCondition_.wait(lock);
+                    }
+                    idle_.fetch_sub(1, std::memory_order_relaxed);
+                    if (channel) {
+                        break;
+                    }
+                }
+                if (stop_) {
+                    return;
+                }
+                channel->busy = true;
+            }
+
+            bool finished = false;
+            std::exception_ptr error;
+            try {
+                finished = fill(*channel, *block);
+            } catch (...) {
+                error = std::current_exception();
+                finished = true;
+            }
+
+            channel->filled.tryPush(block);
+
+            {
+                std::lock_guard< std::mutex > lock{mutex_};
+                channel->busy = false;
+                channel->finished = finished;
+                channel->error = error;
+            }
+            dataCondition_.notify_all();
+        }
+    }
+
+    /// Copy packets into block
+    /// @return True if no more packets in file
+    bool fill(Channel& channel, Block& block)
+    {
+        char* data = block.data.data();
+        std::size_t size = 0;
+
+        while (true) {
+            Packet packet = std::exchange(channel.pending, Packet{});
+            if (!packet) {
+                packet = channel.reader->readPacket();
+                if (!packet) {
+                    block.size = size;
+                    return true;
+                }
+            }
+
+            const std::size_t recordSize = sizeof(Record) + align(packet.captureLength());
+            if (size + recordSize > block.data.size()) {
+                channel.pending = packet;
+                block.size = size;
+                return false;
+            }
+
+            const Record record{packet.timestamp(), packet.captureLength(), packet.length()};
+            std::memcpy(data + size, &record, sizeof(record));
+            std::memcpy(data + size + sizeof(record), packet.data(), packet.captureLength());
+            size += recordSize;
+        }
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_Prefetcher_181026142210 */
@@ -6,28 +6,49 @@
 #define KSERGEY_Reader_160918003931
 
 #include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
 #include <vector>
 #include <utility>
 
 #include <netbox/debug.h>
-#include <netbox/details/byte_order.h>
 #include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/pcap/TimeIndex.h>
+#include <netbox/pcapng/Reader.h>
+#include <netbox/utils/Arena.h>
 #include <netbox/utils/FileReader.h>
 
+#if defined( netbox_PCAP_GZIP )
+#   include <netbox/pcap/GZipIndex.h>
+#endif // defined( netbox_PCAP_GZIP )
+
 namespace netbox::pcap {
 
 /// Single file PCAP file reader
+/// PCAPNG files are detected by the first block and read by `pcapng::Reader`
 class Reader
 {
 private:
-    enum Scale {
-        Up, PassThrough
-    };
-
+    std::string filename_;
+    utils::FileReaderOptions options_;
     utils::FileReader file_;
-    Scale scale_{PassThrough};
+    TimestampScale scale_{TimestampScale::PassThrough};
     int timezone_{0};
-    std::vector< char > buffer_;
+    std::uint32_t snaplen_{0};
+    utils::Arena arena_;
+    std::vector< Packet > batch_;
+    // Packet found by `seek()`
+    Packet pending_;
+    std::uint64_t pendingOffset_{0};
+    std::unique_ptr< TimeIndex > timeIndex_;
+    // Set if reading PCAPNG file
+    std::unique_ptr< pcapng::Reader > ng_;
+
+#if defined( netbox_PCAP_GZIP )
+    std::unique_ptr< GZipIndex > gzipIndex_;
+#endif // defined( netbox_PCAP_GZIP )
 
 public:
     Reader(const Reader&) = delete;
@@ -35,66 +56,269 @@ public:
 
     /// Construct reader
     /// @param[in] filename is path to PCAP file
-    Reader(const char* filename)
-        : file_{filename}
+    /// @param[in] options is file reader tuning
+    Reader(const char* filename, const utils::FileReaderOptions& options = {})
+        : filename_{filename}
+        , options_{options}
+        , file_{filename, options}
     {
-        readFileHeader();
+        open();
     }
 
     /// Return true if file valid
     explicit operator bool() const noexcept
     {
-        return file_.operator bool();
+        return ng_ ? ng_->operator bool() : file_.operator bool();
     }
 
     /// Return true if reader good
     bool good() const noexcept
     {
-        return file_.good();
+        return ng_ ? ng_->good() : file_.good();
     }
 
     /// Return true if end of file reached
     bool eof() const noexcept
     {
-        return file_.eof();
+        return ng_ ? ng_->eof() : file_.eof();
     }
 
     /// Read packet
+    /// The returned packet points into the file read buffer and
+    /// will be available until next read from the reader
     Packet readPacket()
     {
+        if (NETBOX_UNLIKELY(pending_)) {
+            return std::exchange(pending_, Packet{});
+        }
+
+        if (NETBOX_UNLIKELY(ng_)) {
+            return ng_->readPacket();
+        }
+
         PacketHeader header;
+        if (NETBOX_UNLIKELY(!readPacketHeader(header))) {
+            return {};
+        }
 
-        // Read packet header
+        const void* data = file_.fetch(header.caplen);
+        if (NETBOX_UNLIKELY(!data)) {
+            debug("<WARN> Data read of %u failed", header.caplen);
+            return {};
+        }
+
+        return {header, data};
+    }
+
+    /// Read up to `count` packets
+    /// Packets data placed into the arena able to hold `count` records of snaplen size,
+    /// packets will be available until next call `readPackets()` or `readBatch()`
+    /// @return Number of packets read, less than `count` only if no more packets
+    std::size_t readPackets(Packet* packets, std::size_t count)
+    {
+        if (NETBOX_UNLIKELY(ng_)) {
+            return readPacketsNg(packets, count);
+        }
+
+        char* data = arena_.reserve(count * snaplen_);
+
+        std::size_t result = 0;
+        if (NETBOX_UNLIKELY(pending_) && count > 0) {
+            std::memcpy(data, pending_.data(), pending_.captureLength());
+            packets[result++] = Packet{pending_.timestamp(), pending_.captureLength(), pending_.length(), data};
+            data += pending_.captureLength();
+            pending_ = {};
+        }
+
+        while (result < count) {
+            auto packet = readPacketInto(data);
+            if (NETBOX_UNLIKELY(!packet)) {
+                break;
+            }
+            data += packet.captureLength();
+            packets[result++] = packet;
+        }
+
+        return result;
+    }
+
+    /// Read batch of up to `count` packets
+    /// @see readPackets()
+    PacketBatch readBatch(std::size_t count)
+    {
+        if (batch_.size() < count) {
+            batch_.resize(count);
+        }
+        return {batch_.data(), readPackets(batch_.data(), count)};
+    }
+
+    /// Return offset of the next packet record (inside decompressed data)
+    /// @pre Not PCAPNG file
+    std::uint64_t tell() const noexcept
+    {
+        return pending_ ? pendingOffset_ : file_.tell();
+    }
+
+    /// Position reader at the first packet with timestamp not less than `unixTimeNs`
+    /// Uncompressed files use sparse time index kept in sidecar file `<filename>.tsidx`,
+    /// GZip compressed files use checkpoint index kept in sidecar file `<filename>.gzidx`,
+    /// the index is built by scanning whole file on the first seek.
+    /// Other files (and PCAPNG ones) are read from the beginning.
+    /// @return True if such packet found
+    /// @pre Packets of the file are ordered by time
+    bool seek(std::uint64_t unixTimeNs)
+    {
+        pending_ = {};
+
+        if (!rewind(unixTimeNs)) {
+            return false;
+        }
+
+        while (true) {
+            const std::uint64_t offset = ng_ ? 0 : file_.tell();
+            auto packet = readPacket();
+            if (!packet) {
+                break;
+            }
+            if (details::makeUnixTimeNs(packet.timestamp()) >= unixTimeNs) {
+                pending_ = packet;
+                pendingOffset_ = offset;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    /// Reopen file at position before the first packet with timestamp `unixTimeNs`
+    bool rewind(std::uint64_t unixTimeNs)
+    {
+        if (ng_) {
+            ng_ = std::make_unique< pcapng::Reader >(filename_.c_str(), options_);
+            return ng_->operator bool();
+        }
+
+        if (file_.seekable()) {
+            if (!timeIndex_) {
+                timeIndex_ = loadTimeIndex();
+            }
+            auto entry = timeIndex_->find(unixTimeNs);
+            return file_.seek(entry ? entry->offset : sizeof(FileHeader));
+        }
+
+#if defined( netbox_PCAP_GZIP )
+        if (file_.compression() == utils::Compression::GZip) {
+            if (!gzipIndex_) {
+                gzipIndex_ = loadGZipIndex();
+            }
+            if (auto checkpoint = gzipIndex_->find(unixTimeNs); checkpoint) {
+                file_ = utils::FileReader{GZipIndex::open(filename_.c_str(), *checkpoint, options_.direct),
+                    options_, checkpoint->output, utils::Compression::GZip};
+                const std::size_t offset = checkpoint->record - checkpoint->output;
+                return file_.skip(offset) == offset;
+            }
+        }
+#endif // defined( netbox_PCAP_GZIP )
+
+        file_ = utils::FileReader{filename_.c_str(), options_};
+        readFileHeader();
+        return file_.operator bool();
+    }
+
+    /// Detect file format and read file header
+    void open()
+    {
+        std::uint32_t magic;
+        if (auto data = file_.peek(sizeof(magic)); data) {
+            std::memcpy(&magic, data, sizeof(magic));
+            if (magic == pcapng::SectionHeaderBlock) {
+                ng_ = std::make_unique< pcapng::Reader >(std::move(file_));
+                return;
+            }
+        }
+        readFileHeader();
+    }
+
+    std::size_t readPacketsNg(Packet* packets, std::size_t count)
+    {
+        std::size_t result = 0;
+        if (pending_ && count > 0) {
+            // Pending packet points into the buffer, the next read keeps it in place
+            char* data = arena_.reserve(pending_.captureLength());
+            std::memcpy(data, pending_.data(), pending_.captureLength());
+            packets[result++] = Packet{pending_.timestamp(), pending_.captureLength(), pending_.length(), data};
+            pending_ = {};
+        }
+        return result + ng_->readPackets(packets + result, count - result);
+    }
+
+    std::unique_ptr< TimeIndex > loadTimeIndex() const
+    {
+        auto index = std::make_unique< TimeIndex >();
+        const std::string path = filename_ + ".tsidx";
+        if (!index->load(path.c_str(), filename_.c_str())) {
+            Reader reader{filename_.c_str(), options_};
+            while (true) {
+                const std::uint64_t offset = reader.tell();
+                auto packet = reader.readPacket();
+                if (!packet) {
+                    break;
+                }
+                index->add(details::makeUnixTimeNs(packet.timestamp()), offset);
+            }
+            index->save(path.c_str(), filename_.c_str());
+        }
+        return index;
+    }
+
+#if defined( netbox_PCAP_GZIP )
+    std::unique_ptr< GZipIndex > loadGZipIndex() const
+    {
+        auto index = std::make_unique< GZipIndex >();
+        const std::string path = filename_ + ".gzidx";
+        if (!index->load(path.c_str(), filename_.c_str())) {
+            *index = GZipIndex::build(filename_.c_str());
+            index->save(path.c_str(), filename_.c_str());
+        }
+        return index;
+    }
+#endif // defined( netbox_PCAP_GZIP )
+
+    bool readPacketHeader(PacketHeader& header)
+    {
         if (std::uint32_t count = file_.readStruct(header); count != sizeof(header)) {
             if (count != 0) {
                 debug("<WARN> Header read %u of %u", count, sizeof(header));
             }
-            return {};
+            return false;
         }
 
-        switch (scale_) {
-            case Up:
-                header.ts_usec *= 1000;
-                break;
+        scaleTimestamp(header, scale_);
 
-            case PassThrough:
-                break;
+        if (header.caplen > snaplen_) {
+            debug("<WARN> PCAP packet header caplen(%u) greater snaplen", header.caplen);
+            return false;
         }
 
-        if (header.caplen > buffer_.size()) {
-            debug("<WARN> PCAP packet header caplen(%u) greater buffer size", header.caplen);
+        return true;
+    }
+
+    Packet readPacketInto(char* buffer)
+    {
+        PacketHeader header;
+        if (NETBOX_UNLIKELY(!readPacketHeader(header))) {
             return {};
         }
 
-        if (std::uint32_t count = file_.read(buffer_.data(), header.caplen); count != header.caplen) {
+        if (std::uint32_t count = file_.read(buffer, header.caplen); count != header.caplen) {
             debug("<WARN> Data read %u of %u", count, header.caplen);
             return {};
         }
 
-        return {header, buffer_.data()};
+        return {header, buffer};
     }
 
-private:
     void readFileHeader()
     {
         FileHeader header;
@@ -104,37 +328,15 @@ private:
             return (file_ = {}), debug("<WARN> Read PCAP header error");
         }
 
-        switch (header.magic) {
-            case TCPDumpMagic:
-                scale_ = Up;
-                break;
-
-            case NSecTCPDumpMagic:
-                scale_ = PassThrough;
-                break;
-
-            case details::hostToNetwork32(TCPDumpMagic):
-            case details::hostToNetwork32(NSecTCPDumpMagic):
-                return (file_ = {}), debug("<WARN> Byte swapped PCAP not support");
-
-            default:
-                return (file_ = {}), debug("<WARN> Unknown PCAP header %08x", header.magic);
-        }
-
-        if (header.snaplen > MaxSnapLen) {
-            return (file_ = {}), debug("<WARN> Invalid file capture length %u, bigger than maximum of %u",
-                    header.snaplen, MaxSnapLen);
-        }
-
-        if (header.linktype != Ethernet) {
-            return (file_ = {}), debug("<WARN> Linktype %u not supported", header.linktype);
+        if (!checkFileHeader(header, scale_)) {
+            file_ = {};
+            return;
         }
 
         // Timezone correction
         timezone_ = header.thiszone;
 
-        // Prepare buffer
-        buffer_.resize(header.snaplen);
+        snaplen_ = header.snaplen;
     }
 };
 
@@ -0,0 +1,124 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Sidecar_181026160245
+#define KSERGEY_Sidecar_181026160245
+
+#include <sys/stat.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <netbox/debug.h>
+
+namespace netbox::pcap {
+
+/// Index file stored next to indexed file
+/// Holds array of plain records, rejected on load if indexed file
+/// changed (size or modification time) since the index saved.
+class Sidecar
+{
+private:
+    struct Header
+    {
+        char magic[8];
+        std::uint64_t fileSize;
+        std::int64_t fileTime;
+        std::uint64_t count;
+    };
+
+    using FilePtr = std::unique_ptr< std::FILE, int (*)(std::FILE*) >;
+
+public:
+    /// Load records from sidecar file
+    /// @param[in] path is path to sidecar file
+    /// @param[in] filename is path to indexed file
+    /// @param[in] magic is 8 bytes identifying index type
+    /// @param[out] records is loaded records
+    /// @return True on success
+    template< class T >
+    static bool load(const char* path, const char* filename, const char (&magic)[8], std::vector< T >& records)
+    {
+        static_assert( std::is_trivially_copyable< T >(), "Non trivially copyable type" );
+
+        FilePtr file{std::fopen(path, "rb"), std::fclose};
+        if (!file) {
+            return false;
+        }
+
+        Header header;
+        if (std::fread(&header, sizeof(header), 1, file.get()) != 1
+                || std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+            return debug("<WARN> Invalid index \"%s\"", path), false;
+        }
+
+        struct stat st;
+        if (::stat(filename, &st) != 0 || std::uint64_t(st.st_size) != header.fileSize
+                || st.st_mtime != header.fileTime) {
+            return debug("<WARN> Index \"%s\" out of date", path), false;
+        }
+
+        // Count is checked against the file size before allocation
+        if (::fstat(::fileno(file.get()), &st) != 0 || std::uint64_t(st.st_size) < sizeof(header)
+                || (std::uint64_t(st.st_size) - sizeof(header)) / sizeof(T) != header.count
+                || (std::uint64_t(st.st_size) - sizeof(header)) % sizeof(T) != 0) {
+            return debug("<WARN> Invalid index \"%s\"", path), false;
+        }
+
+        std::vector< T > result(header.count);
+        if (header.count != 0 && std::fread(result.data(), sizeof(T), header.count, file.get()) != header.count) {
+            return debug("<WARN> Invalid index \"%s\"", path), false;
+        }
+
+        records = std::move(result);
+        return true;
+    }
+
+    /// Save records into sidecar file
+    /// The file is written under temporary name and renamed, so it is never seen partially written.
+    /// @param[in] path is path to sidecar file
+    /// @param[in] filename is path to indexed file
+    /// @param[in] magic is 8 bytes identifying index type
+    /// @param[in] records is records to save
+    /// @return True on success
+    template< class T >
+    static bool save(const char* path, const char* filename, const char (&magic)[8], const std::vector< T >& records)
+    {
+        static_assert( std::is_trivially_copyable< T >(), "Non trivially copyable type" );
+
+        struct stat st;
+        if (::stat(filename, &st) != 0) {
+            return false;
+        }
+
+        const std::string temporary = std::string{path} + ".tmp";
+        FilePtr file{std::fopen(temporary.c_str(), "wb"), std::fclose};
+        if (!file) {
+            return debug("<WARN> Index \"%s\" write error", path), false;
+        }
+
+        Header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.fileSize = st.st_size;
+        header.fileTime = st.st_mtime;
+        header.count = records.size();
+
+        const bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1
+            && (header.count == 0 || std::fwrite(records.data(), sizeof(T), header.count, file.get()) == header.count);
+        if (std::fclose(file.release()) != 0 || !written || std::rename(temporary.c_str(), path) != 0) {
+            std::remove(temporary.c_str());
+            return debug("<WARN> Index \"%s\" write error", path), false;
+        }
+
+        return true;
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_Sidecar_181026160245 */
@@ -0,0 +1,109 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_TimeIndex_181026161012
+#define KSERGEY_TimeIndex_181026161012
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <netbox/pcap/Sidecar.h>
+
+namespace netbox::pcap {
+
+/// Sparse time index of PCAP file
+/// Holds (timestamp, offset) of a PCAP record every `span` bytes of file.
+class TimeIndex
+{
+public:
+    /// Default distance between indexed records
+    static constexpr std::size_t DefaultSpan = 1024 * 1024;
+
+    /// Indexed record
+    struct Entry
+    {
+        /// Timestamp of the record (nanoseconds since Epoch)
+        std::uint64_t timestamp;
+        /// Offset of the record inside file
+        std::uint64_t offset;
+    };
+
+private:
+    static constexpr char Magic[8] = {'N', 'B', 'T', 'S', 'I', 'D', 'X', '1'};
+
+    std::vector< Entry > entries_;
+    std::size_t span_{DefaultSpan};
+
+public:
+    /// Construct empty index
+    /// @param[in] span is distance between indexed records
+    explicit TimeIndex(std::size_t span = DefaultSpan)
+        : span_{span}
+    {}
+
+    /// Return number of entries
+    std::size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    /// Return true if no entries
+    bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    /// Return entry by index
+    const Entry& operator[](std::size_t index) const noexcept
+    {
+        return entries_[index];
+    }
+
+    /// Add record to index, records should be added in file order
+    /// Record is indexed only if it is `span` bytes far from the last indexed one
+    void add(std::uint64_t timestamp, std::uint64_t offset)
+    {
+        if (entries_.empty() || offset - entries_.back().offset >= span_) {
+            entries_.push_back({timestamp, offset});
+        }
+    }
+
+    /// Find the last entry with timestamp less than `unixTimeNs`
+    /// @return Entry or `nullptr` if the file should be read from the beginning
+    /// @pre PCAP records are ordered by time
+    const Entry* find(std::uint64_t unixTimeNs) const noexcept
+    {
+        auto found = std::lower_bound(entries_.begin(), entries_.end(), unixTimeNs,
+                [](const Entry& entry, std::uint64_t value) {
+                    return entry.timestamp < value;
+                });
+        if (found == entries_.begin()) {
+            return nullptr;
+        }
+        return &*(found - 1);
+    }
+
+    /// Load index from sidecar file
+    /// @param[in] path is path to sidecar file
+    /// @param[in] filename is path to indexed file, index is rejected if file modified
+    /// @return True on success
+    bool load(const char* path, const char* filename)
+    {
+        return Sidecar::load(path, filename, Magic, entries_);
+    }
+
+    /// Save index into sidecar file
+    /// @param[in] path is path to sidecar file
+    /// @param[in] filename is path to indexed file
+    /// @return True on success
+    bool save(const char* path, const char* filename) const
+    {
+        return Sidecar::save(path, filename, Magic, entries_);
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_TimeIndex_181026161012 */
@@ -0,0 +1,101 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Writer_181026173512
+#define KSERGEY_Writer_181026173512
+
+#include <algorithm>
+
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/pcap/pcap.h>
+#include <netbox/utils/FileWriter.h>
+
+namespace netbox::pcap {
+
+/// Single file PCAP file writer
+/// Writes nanosecond resolution PCAP, records are coalesced into large buffers,
+/// gzip and zstd compression is selected by file name suffix (`.gz`, `.zst`).
+class Writer
+{
+private:
+    utils::FileWriter file_;
+    std::uint32_t snaplen_{MaxSnapLen};
+
+public:
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /// Create (or truncate) PCAP file and write file header
+    /// @param[in] filename is path to PCAP file
+    /// @param[in] options is file writer tuning
+    /// @param[in] snaplen is maximum number of packet bytes written
+    /// @throw std::runtime_error if file open or write error
+    Writer(const char* filename, const utils::FileWriterOptions& options = {},
+            std::uint32_t snaplen = MaxSnapLen)
+        : file_{filename, options}
+        , snaplen_{std::min(snaplen, MaxSnapLen)}
+    {
+        FileHeader header{};
+        header.magic = NSecTCPDumpMagic;
+        header.version_major = 2;
+        header.version_minor = 4;
+        header.snaplen = snaplen_;
+        header.linktype = Ethernet;
+        file_.writeStruct(header);
+    }
+
+    /// Return true if file open
+    explicit operator bool() const noexcept
+    {
+        return file_.operator bool();
+    }
+
+    /// Write packet, data beyond snaplen is truncated
+    /// @throw std::runtime_error on write error
+    void write(const Packet& packet)
+    {
+        PacketHeader header;
+        header.ts_sec = packet.timestamp().tv_sec;
+        header.ts_usec = packet.timestamp().tv_nsec;
+        header.caplen = std::min(packet.captureLength(), snaplen_);
+        header.len = packet.length();
+        file_.writeStruct(header);
+        file_.write(packet.data(), header.caplen);
+    }
+
+    /// Write `count` packets
+    /// @throw std::runtime_error on write error
+    void write(const Packet* packets, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            write(packets[i]);
+        }
+    }
+
+    /// Write batch of packets
+    /// @throw std::runtime_error on write error
+    void write(PacketBatch batch)
+    {
+        write(batch.begin(), batch.size());
+    }
+
+    /// Pass buffered records to the file (or encoder)
+    /// @throw std::runtime_error on write error
+    void flush()
+    {
+        file_.flush();
+    }
+
+    /// Write buffered records, complete encoded stream and close the file
+    /// @throw std::runtime_error on write error
+    void close()
+    {
+        file_.close();
+    }
+};
+
+} /* namespace netbox::pcap */
+
+#endif /* KSERGEY_Writer_181026173512 */
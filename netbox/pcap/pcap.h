@@ -9,6 +9,8 @@
 #include <cstdint>
 
 #include <netbox/compiler.h>
+#include <netbox/debug.h>
+#include <netbox/details/byte_order.h>
 
 namespace netbox::pcap {
 
@@ -48,6 +50,61 @@ struct PacketHeader {
 	std::uint32_t len;      // length this packet (off wire)
 };
 
+/// Packet timestamp fraction conversion to nanoseconds
+enum class TimestampScale
+{
+    Up,
+    PassThrough
+};
+
+/// Check PCAP file header is supported
+/// @param[in] header is file header
+/// @param[out] scale is timestamp conversion for packets of the file
+/// @return True if file could be read
+inline bool checkFileHeader(const FileHeader& header, TimestampScale& scale) noexcept
+{
+    switch (header.magic) {
+        case TCPDumpMagic:
+            scale = TimestampScale::Up;
+            break;
+
+        case NSecTCPDumpMagic:
+            scale = TimestampScale::PassThrough;
+            break;
+
+        case details::hostToNetwork32(TCPDumpMagic):
+        case details::hostToNetwork32(NSecTCPDumpMagic):
+            return debug("<WARN> Byte swapped PCAP not support"), false;
+
+        default:
+            return debug("<WARN> Unknown PCAP header %08x", header.magic), false;
+    }
+
+    if (header.snaplen > MaxSnapLen) {
+        return debug("<WARN> Invalid file capture length %u, bigger than maximum of %u",
+                header.snaplen, MaxSnapLen), false;
+    }
+
+    if (header.linktype != Ethernet) {
+        return debug("<WARN> Linktype %u not supported", header.linktype), false;
+    }
+
+    return true;
+}
+
+/// Convert packet header timestamp fraction to nanoseconds
+constexpr void scaleTimestamp(PacketHeader& header, TimestampScale scale) noexcept
+{
+    switch (scale) {
+        case TimestampScale::Up:
+            header.ts_usec *= 1000;
+            break;
+
+        case TimestampScale::PassThrough:
+            break;
+    }
+}
+
 } /* namespace netbox::pcap */
 
 #endif /* KSERGEY_pcap_150318120952 */
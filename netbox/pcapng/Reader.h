@@ -0,0 +1,385 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Reader_181026163847
+#define KSERGEY_Reader_181026163847
+
+#include <cstring>
+#include <vector>
+
+#include <netbox/debug.h>
+#include <netbox/pcap/Packet.h>
+#include <netbox/pcap/PacketBatch.h>
+#include <netbox/pcap/pcap.h>
+#include <netbox/pcapng/pcapng.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/FileReader.h>
+
+namespace netbox::pcapng {
+
+/// Single file PCAPNG reader
+/// Walks blocks inside the file read buffer, packets of Enhanced (and Simple)
+/// Packet Blocks point into the buffer. Timestamps are converted to nanoseconds
+/// according to interface resolution and offset. Sections of any byte order
+/// are supported, packets of non Ethernet interfaces are skipped.
+class Reader
+{
+private:
+    struct Interface
+    {
+        std::uint32_t linktype{0};
+        std::uint32_t snaplen{0};
+        // Timestamp units per second for decimal resolution, 0 for binary one
+        std::uint64_t unitsPerSecond{1000000};
+        // Exponent of binary resolution
+        std::uint32_t shift{0};
+        // Seconds added to timestamps
+        std::int64_t offset{0};
+    };
+
+    utils::FileReader file_;
+    std::vector< Interface > interfaces_;
+    bool swapped_{false};
+    bool good_{false};
+    utils::Arena arena_;
+    std::vector< pcap::Packet > batch_;
+
+public:
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    /// Construct reader
+    /// @param[in] filename is path to PCAPNG file
+    /// @param[in] options is file reader tuning
+    Reader(const char* filename, const utils::FileReaderOptions& options = {})
+        : Reader{utils::FileReader{filename, options}}
+    {}
+
+    /// Construct reader over opened file
+    /// @param[in] file is file positioned at Section Header Block
+    explicit Reader(utils::FileReader file)
+        : file_{std::move(file)}
+    {
+        std::uint32_t type;
+        if (auto data = file_.peek(sizeof(type)); !data) {
+            debug("<WARN> Read PCAPNG header error");
+        } else if (std::memcpy(&type, data, sizeof(type)); type != SectionHeaderBlock) {
+            debug("<WARN> Unknown PCAPNG header %08x", type);
+        } else {
+            good_ = true;
+        }
+    }
+
+    /// Return true if file valid
+    explicit operator bool() const noexcept
+    {
+        return good_ && file_.operator bool();
+    }
+
+    /// Return true if reader good
+    bool good() const noexcept
+    {
+        return good_ && file_.good();
+    }
+
+    /// Return true if end of file reached
+    bool eof() const noexcept
+    {
+        return file_.eof();
+    }
+
+    /// Read packet
+    /// The returned packet points into the file read buffer and
+    /// will be available until next read from the reader
+    pcap::Packet readPacket()
+    {
+        while (NETBOX_LIKELY(good_)) {
+            BlockHeader header;
+            if (NETBOX_UNLIKELY(file_.readStruct(header) != sizeof(header))) {
+                return {};
+            }
+
+            if (NETBOX_UNLIKELY(header.type == SectionHeaderBlock)) {
+                if (!readSectionHeader(header)) {
+                    return fail();
+                }
+                continue;
+            }
+
+            const std::uint32_t length = fix(header.length);
+            if (NETBOX_UNLIKELY(length < sizeof(header) + sizeof(std::uint32_t) || length % 4 != 0)) {
+                debug("<WARN> Invalid PCAPNG block length %u", length);
+                return fail();
+            }
+
+            // Block body and trailing length
+            const std::size_t size = length - sizeof(header);
+            const std::uint32_t type = fix(header.type);
+            if (type != EnhancedPacketBlock && type != SimplePacketBlock && type != InterfaceDescriptionBlock) {
+                // Statistics, name resolution, custom blocks, etc
+                if (NETBOX_UNLIKELY(file_.skip(size) != size)) {
+                    debug("<WARN> PCAPNG block skip of %zu failed", size);
+                    return {};
+                }
+                continue;
+            }
+
+            const char* body = static_cast< const char* >(file_.fetch(size));
+            if (NETBOX_UNLIKELY(!body)) {
+                debug("<WARN> PCAPNG block read of %zu failed", size);
+                return {};
+            }
+            const std::size_t bodySize = size - sizeof(std::uint32_t);
+
+            if (type == InterfaceDescriptionBlock) {
+                if (!parseInterface(body, bodySize)) {
+                    return fail();
+                }
+                continue;
+            }
+
+            auto packet = type == EnhancedPacketBlock
+                ? parseEnhancedPacket(body, bodySize)
+                : parseSimplePacket(body, bodySize);
+            if (NETBOX_LIKELY(packet)) {
+                return packet;
+            }
+        }
+
+        return {};
+    }
+
+    /// Read up to `count` packets
+    /// Packets data copied into the arena able to hold `count` records of maximum snaplen,
+    /// packets will be available until next call `readPackets()` or `readBatch()`
+    /// @return Number of packets read, less than `count` only if no more packets
+    std::size_t readPackets(pcap::Packet* packets, std::size_t count)
+    {
+        char* data = arena_.reserve(count * pcap::MaxSnapLen);
+
+        std::size_t result = 0;
+        while (result < count) {
+            auto packet = readPacket();
+            if (NETBOX_UNLIKELY(!packet)) {
+                break;
+            }
+            std::memcpy(data, packet.data(), packet.captureLength());
+            packets[result++] = pcap::Packet{packet.timestamp(), packet.captureLength(), packet.length(), data};
+            data += packet.captureLength();
+        }
+
+        return result;
+    }
+
+    /// Read batch of up to `count` packets
+    /// @see readPackets()
+    pcap::PacketBatch readBatch(std::size_t count)
+    {
+        if (batch_.size() < count) {
+            batch_.resize(count);
+        }
+        return {batch_.data(), readPackets(batch_.data(), count)};
+    }
+
+private:
+    pcap::Packet fail() noexcept
+    {
+        good_ = false;
+        return {};
+    }
+
+    std::uint16_t fix(std::uint16_t value) const noexcept
+    {
+        return swapped_ ? __builtin_bswap16(value) : value;
+    }
+
+    std::uint32_t fix(std::uint32_t value) const noexcept
+    {
+        return swapped_ ? __builtin_bswap32(value) : value;
+    }
+
+    std::uint64_t fix(std::uint64_t value) const noexcept
+    {
+        return swapped_ ? __builtin_bswap64(value) : value;
+    }
+
+    /// Start new section, interfaces are per section
+    bool readSectionHeader(const BlockHeader& header)
+    {
+        SectionHeader section;
+        if (file_.readStruct(section) != sizeof(section)) {
+            return debug("<WARN> PCAPNG section header read failed"), false;
+        }
+
+        if (section.magic == ByteOrderMagic) {
+            swapped_ = false;
+        } else if (section.magic == __builtin_bswap32(ByteOrderMagic)) {
+            swapped_ = true;
+        } else {
+            return debug("<WARN> Invalid PCAPNG byte-order magic %08x", section.magic), false;
+        }
+
+        if (fix(section.version_major) != 1) {
+            return debug("<WARN> PCAPNG version %u not supported", fix(section.version_major)), false;
+        }
+
+        const std::uint32_t length = fix(header.length);
+        const std::size_t fixedSize = sizeof(header) + sizeof(section) + sizeof(std::uint32_t);
+        if (length < fixedSize || length % 4 != 0) {
+            return debug("<WARN> Invalid PCAPNG block length %u", length), false;
+        }
+
+        // Section options are not used
+        const std::size_t size = length - sizeof(header) - sizeof(section);
+        if (file_.skip(size) != size) {
+            return debug("<WARN> PCAPNG section header read failed"), false;
+        }
+
+        interfaces_.clear();
+        return true;
+    }
+
+    bool parseInterface(const char* body, std::size_t size)
+    {
+        InterfaceDescription description;
+        if (size < sizeof(description)) {
+            return debug("<WARN> Invalid PCAPNG interface block"), false;
+        }
+        std::memcpy(&description, body, sizeof(description));
+
+        Interface& interface = interfaces_.emplace_back();
+        interface.linktype = fix(description.linktype);
+        interface.snaplen = fix(description.snaplen);
+
+        if (interface.linktype != pcap::Ethernet) {
+            debug("<WARN> PCAPNG interface %zu linktype %u not supported, packets skipped",
+                    interfaces_.size() - 1, interface.linktype);
+        }
+
+        // Options
+        const char* cursor = body + sizeof(description);
+        const char* end = body + size;
+        while (std::size_t(end - cursor) >= sizeof(OptionHeader)) {
+            OptionHeader option;
+            std::memcpy(&option, cursor, sizeof(option));
+            cursor += sizeof(option);
+
+            const std::uint16_t code = fix(option.code);
+            const std::uint16_t length = fix(option.length);
+            if (code == EndOfOpt || std::size_t(end - cursor) < length) {
+                break;
+            }
+
+            if (code == IfTsResol && length == 1) {
+                const std::uint8_t resolution = *cursor;
+                if (resolution & 0x80) {
+                    interface.unitsPerSecond = 0;
+                    interface.shift = resolution & 0x7f;
+                    if (interface.shift >= 64) {
+                        return debug("<WARN> PCAPNG timestamp resolution 2^-%u not supported", interface.shift), false;
+                    }
+                } else {
+                    if (resolution > 19) {
+                        return debug("<WARN> PCAPNG timestamp resolution 10^-%u not supported", resolution), false;
+                    }
+                    interface.unitsPerSecond = 1;
+                    for (std::uint8_t i = 0; i < resolution; ++i) {
+                        interface.unitsPerSecond *= 10;
+                    }
+                }
+            } else if (code == IfTsOffset && length == 8) {
+                std::uint64_t offset;
+                std::memcpy(&offset, cursor, sizeof(offset));
+                interface.offset = fix(offset);
+            }
+
+            cursor += (length + 3) & ~3u;
+        }
+
+        return true;
+    }
+
+    pcap::Packet parseEnhancedPacket(const char* body, std::size_t size)
+    {
+        EnhancedPacket header;
+        if (NETBOX_UNLIKELY(size < sizeof(header))) {
+            debug("<WARN> Invalid PCAPNG packet block");
+            return fail();
+        }
+        std::memcpy(&header, body, sizeof(header));
+
+        const std::uint32_t id = fix(header.interface_id);
+        const std::uint32_t caplen = fix(header.caplen);
+        if (NETBOX_UNLIKELY(id >= interfaces_.size())) {
+            debug("<WARN> PCAPNG packet of unknown interface %u", id);
+            return fail();
+        }
+        if (NETBOX_UNLIKELY(caplen > size - sizeof(header) || caplen > pcap::MaxSnapLen)) {
+            debug("<WARN> PCAPNG packet caplen(%u) invalid", caplen);
+            return fail();
+        }
+
+        const Interface& interface = interfaces_[id];
+        if (NETBOX_UNLIKELY(interface.linktype != pcap::Ethernet)) {
+            return {};
+        }
+
+        const std::uint64_t timestamp = (std::uint64_t(fix(header.ts_high)) << 32) | fix(header.ts_low);
+        return {makeTimestamp(interface, timestamp), caplen, fix(header.len), body + sizeof(header)};
+    }
+
+    pcap::Packet parseSimplePacket(const char* body, std::size_t size)
+    {
+        SimplePacket header;
+        if (NETBOX_UNLIKELY(size < sizeof(header) || interfaces_.empty())) {
+            debug("<WARN> Invalid PCAPNG simple packet block");
+            return fail();
+        }
+        std::memcpy(&header, body, sizeof(header));
+
+        const Interface& interface = interfaces_.front();
+        if (NETBOX_UNLIKELY(interface.linktype != pcap::Ethernet)) {
+            return {};
+        }
+
+        // Captured length is implied by block length and interface snaplen
+        std::uint32_t caplen = std::min< std::size_t >(fix(header.len), size - sizeof(header));
+        if (interface.snaplen != 0) {
+            caplen = std::min(caplen, interface.snaplen);
+        }
+        if (NETBOX_UNLIKELY(caplen > pcap::MaxSnapLen)) {
+            debug("<WARN> PCAPNG packet caplen(%u) invalid", caplen);
+            return fail();
+        }
+
+        // No timestamp in the block
+        return {timespec{}, caplen, fix(header.len), body + sizeof(header)};
+    }
+
+    /// Convert timestamp in interface units to time since Epoch
+    static timespec makeTimestamp(const Interface& interface, std::uint64_t timestamp) noexcept
+    {
+        constexpr std::uint64_t NanosecondsPerSecond = 1000000000;
+
+        std::uint64_t sec;
+        std::uint64_t nsec;
+        if (NETBOX_LIKELY(interface.unitsPerSecond != 0)) {
+            sec = timestamp / interface.unitsPerSecond;
+            const std::uint64_t fraction = timestamp % interface.unitsPerSecond;
+            nsec = interface.unitsPerSecond <= NanosecondsPerSecond
+                ? fraction * (NanosecondsPerSecond / interface.unitsPerSecond)
+                : fraction / (interface.unitsPerSecond / NanosecondsPerSecond);
+        } else {
+            sec = timestamp >> interface.shift;
+            const std::uint64_t fraction = timestamp & ((std::uint64_t(1) << interface.shift) - 1);
+            nsec = static_cast< std::uint64_t >((static_cast< unsigned __int128 >(fraction) * NanosecondsPerSecond) >> interface.shift);
+        }
+
+        return timespec{static_cast< time_t >(sec + interface.offset), static_cast< long >(nsec)};
+    }
+};
+
+} /* namespace netbox::pcapng */
+
+#endif /* KSERGEY_Reader_181026163847 */
@@ -0,0 +1,79 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_pcapng_181026163512
+#define KSERGEY_pcapng_181026163512
+
+#include <cstdint>
+
+namespace netbox::pcapng {
+
+enum BlockType : std::uint32_t
+{
+    InterfaceDescriptionBlock   = 0x00000001,
+    SimplePacketBlock           = 0x00000003,
+    EnhancedPacketBlock         = 0x00000006,
+    SectionHeaderBlock          = 0x0a0d0d0a
+};
+
+/// Section header byte-order magic
+static constexpr std::uint32_t ByteOrderMagic = 0x1a2b3c4d;
+
+enum OptionCode : std::uint16_t
+{
+    EndOfOpt    = 0,
+    IfTsResol   = 9,
+    IfTsOffset  = 14
+};
+
+/// Common part of all blocks, followed by body and trailing total length
+struct BlockHeader
+{
+    std::uint32_t type;
+    std::uint32_t length;   // Total block length
+};
+
+/// Section Header Block body
+struct SectionHeader
+{
+    std::uint32_t magic;
+    std::uint16_t version_major;
+    std::uint16_t version_minor;
+    std::int64_t section_length;
+};
+
+/// Interface Description Block body, followed by options
+struct InterfaceDescription
+{
+    std::uint16_t linktype;
+    std::uint16_t reserved;
+    std::uint32_t snaplen;
+};
+
+/// Enhanced Packet Block body, followed by packet data and options
+struct EnhancedPacket
+{
+    std::uint32_t interface_id;
+    std::uint32_t ts_high;
+    std::uint32_t ts_low;
+    std::uint32_t caplen;
+    std::uint32_t len;
+};
+
+/// Simple Packet Block body, followed by packet data
+struct SimplePacket
+{
+    std::uint32_t len;
+};
+
+/// Option header, followed by value padded to 32 bits
+struct OptionHeader
+{
+    std::uint16_t code;
+    std::uint16_t length;
+};
+
+} /* namespace netbox::pcapng */
+
+#endif /* KSERGEY_pcapng_181026163512 */
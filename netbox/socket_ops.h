@@ -10,6 +10,7 @@
 #include <netdb.h>
 
 #include <netbox/buffer.h>
+#include <netbox/ControlMessages.h>
 #include <netbox/details/concepts.h>
 #include <netbox/IPv4.h>
 #include <netbox/IPv6.h>
@@ -152,6 +153,31 @@ NETBOX_FORCE_INLINE TransmitResult recvmsg(Socket& socket, msghdr* message) noex
     return ::recvmsg(socket.native(), message, 0);
 }
 
+/// Recv data from socket with its receive timestamps
+/// Timestamping should be enabled on socket (`Options::Socket::TimestampNS`, `Options::Socket::Timestamping`)
+NETBOX_FORCE_INLINE TransmitResult recvmsg(Socket& socket, void* buf, std::size_t len, ReceiveTimestamps& timestamps,
+        sockaddr* src_addr = nullptr, socklen_t* addrlen = nullptr) noexcept
+{
+    TimestampsControlBuffer control;
+    iovec iov{buf, len};
+    msghdr message{};
+    message.msg_name = src_addr;
+    message.msg_namelen = addrlen ? *addrlen : 0;
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data;
+    message.msg_controllen = sizeof(control.data);
+
+    TransmitResult result = ::recvmsg(socket.native(), &message, 0);
+    if (NETBOX_LIKELY(result.native() == 0)) {
+        timestamps = receiveTimestamps(message);
+        if (addrlen) {
+            *addrlen = message.msg_namelen;
+        }
+    }
+    return result;
+}
+
 /// @overload
 NETBOX_FORCE_INLINE TransmitResult recvfrom(Socket& socket, const MutableBuffer& buf, sockaddr* src_addr, socklen_t* addrlen) noexcept
 {
@@ -164,6 +190,12 @@ NETBOX_FORCE_INLINE TransmitResult recvmmsg(Socket& socket, mmsghdr* msgvec, uns
     return ::recvmmsg(socket.native(), msgvec, vlen, 0, timeout);
 }
 
+/// Send multiple data into socket
+NETBOX_FORCE_INLINE TransmitResult sendmmsg(Socket& socket, mmsghdr* msgvec, unsigned int vlen) noexcept
+{
+    return ::sendmmsg(socket.native(), msgvec, vlen, 0);
+}
+
 } /* namespace netbox */
 
 #endif /* KSERGEY_socket_ops_160918005452 */
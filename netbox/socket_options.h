@@ -37,10 +37,15 @@ struct Options
     struct Socket
     {
         using ReuseAddr = details::BooleanOption< SOL_SOCKET, SO_REUSEADDR >;
+        using ReusePort = details::BooleanOption< SOL_SOCKET, SO_REUSEPORT >;
+        using IncomingCpu = details::IntegerOption< SOL_SOCKET, SO_INCOMING_CPU >;
+        using AttachReusePortCBPF = details::StructOption< SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, sock_fprog >;
         using Timestamp = details::BooleanOption< SOL_SOCKET, SO_TIMESTAMP >;
         using TimestampNS = details::BooleanOption< SOL_SOCKET, SO_TIMESTAMPNS >;
+        using Timestamping = details::IntegerOption< SOL_SOCKET, SO_TIMESTAMPING >;
         using RcvBuf = details::IntegerOption< SOL_SOCKET, SO_RCVBUF >;
         using SndBuf = details::IntegerOption< SOL_SOCKET, SO_SNDBUF >;
+        using ZeroCopy = details::BooleanOption< SOL_SOCKET, SO_ZEROCOPY >;
     };
 
     /// Packet options
@@ -49,6 +54,27 @@ struct Options
         using Timestamp = details::IntegerOption< SOL_PACKET, PACKET_TIMESTAMP >;
         using Version = details::IntegerOption< SOL_PACKET, PACKET_VERSION >;
         using RxRing = details::StructOption< SOL_PACKET, PACKET_RX_RING, tpacket_req& >;
+        using RxRingV3 = details::StructOption< SOL_PACKET, PACKET_RX_RING, tpacket_req3 >;
+        using AddMembership = details::StructOption< SOL_PACKET, PACKET_ADD_MEMBERSHIP, packet_mreq >;
+        using Fanout = details::IntegerOption< SOL_PACKET, PACKET_FANOUT >;
+        using StatisticsV3 = details::StructOption< SOL_PACKET, PACKET_STATISTICS, tpacket_stats_v3 >;
+        using TxRing = details::StructOption< SOL_PACKET, PACKET_TX_RING, tpacket_req >;
+        using QdiscBypass = details::BooleanOption< SOL_PACKET, PACKET_QDISC_BYPASS >;
+        using Loss = details::BooleanOption< SOL_PACKET, PACKET_LOSS >;
+    };
+
+    /// AF_XDP options
+    struct Xdp
+    {
+        using UmemReg = details::StructOption< SOL_XDP, XDP_UMEM_REG, xdp_umem_reg >;
+        using FillRing = details::IntegerOption< SOL_XDP, XDP_UMEM_FILL_RING >;
+        using CompletionRing = details::IntegerOption< SOL_XDP, XDP_UMEM_COMPLETION_RING >;
+        using RxRing = details::IntegerOption< SOL_XDP, XDP_RX_RING >;
+        using TxRing = details::IntegerOption< SOL_XDP, XDP_TX_RING >;
+        using MmapOffsets = details::StructOption< SOL_XDP, XDP_MMAP_OFFSETS, xdp_mmap_offsets >;
+        // Kernels before 5.9 return the first three counters only
+        using Statistics = details::StructOption< SOL_XDP, XDP_STATISTICS, xdp_statistics,
+            offsetof(xdp_statistics, rx_ring_full) >;
     };
 
     /// TCP options
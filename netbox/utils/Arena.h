@@ -0,0 +1,83 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Arena_171026111847
+#define KSERGEY_Arena_171026111847
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace netbox::utils {
+
+/// Growable block of uninitialized page aligned memory
+/// Memory pages are not touched until written, so a large arena
+/// costs only as much as actually used.
+class Arena
+{
+public:
+    /// Arena memory and size alignment
+    static constexpr std::size_t Alignment = 4096;
+
+private:
+    struct Deleter
+    {
+        void operator()(char* data) const noexcept
+        {
+            std::free(data);
+        }
+    };
+
+    std::unique_ptr< char[], Deleter > data_;
+    std::size_t size_{0};
+
+public:
+    Arena() = default;
+
+    /// Construct arena of at least `size` bytes
+    explicit Arena(std::size_t size)
+    {
+        reserve(size);
+    }
+
+    /// Make arena at least `size` bytes, previous content is lost on growth
+    /// @return Pointer to arena memory
+    /// @throw std::bad_alloc if allocation failed
+    char* reserve(std::size_t size)
+    {
+        if (size > size_) {
+            size = (size + Alignment - 1) & ~(Alignment - 1);
+            data_.reset(static_cast< char* >(std::aligned_alloc(Alignment, size)));
+            if (!data_) {
+                size_ = 0;
+                throw std::bad_alloc{};
+            }
+            size_ = size;
+        }
+        return data_.get();
+    }
+
+    /// Return pointer to arena memory
+    char* data() noexcept
+    {
+        return data_.get();
+    }
+
+    /// @overload
+    const char* data() const noexcept
+    {
+        return data_.get();
+    }
+
+    /// Return arena size
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_Arena_171026111847 */
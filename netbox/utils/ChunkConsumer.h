@@ -0,0 +1,34 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ChunkConsumer_181026170214
+#define KSERGEY_ChunkConsumer_181026170214
+
+#include <sys/uio.h>
+#include <cstddef>
+
+namespace netbox::utils {
+
+/// Sink of sequential data consumed in chunks
+/// (raw file contents, compressed data, etc...)
+class ChunkConsumer
+{
+public:
+    virtual ~ChunkConsumer() noexcept = default;
+
+    /// Consume next chunks of data, in order
+    /// @param[in] chunks is array of chunks
+    /// @param[in] count is number of chunks
+    /// @throw std::runtime_error on write error
+    virtual void consume(const iovec* chunks, std::size_t count) = 0;
+
+    /// Complete the data (write buffered data, trailers, etc...)
+    /// No data could be consumed after
+    /// @throw std::runtime_error on write error
+    virtual void finish() = 0;
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_ChunkConsumer_181026170214 */
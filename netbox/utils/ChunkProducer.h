@@ -0,0 +1,28 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ChunkProducer_171026131020
+#define KSERGEY_ChunkProducer_171026131020
+
+#include <cstddef>
+
+namespace netbox::utils {
+
+/// Source of sequential data produced in chunks
+/// (raw file contents, decompressed data, etc...)
+class ChunkProducer
+{
+public:
+    virtual ~ChunkProducer() noexcept = default;
+
+    /// Produce next chunk of data
+    /// @param[in] buffer is pointer to output buffer
+    /// @param[in] size is output buffer size
+    /// @return Bytes produced, 0 if no more data available
+    virtual std::size_t produce(void* buffer, std::size_t size) = 0;
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_ChunkProducer_171026131020 */
@@ -0,0 +1,81 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_Compression_181026121530
+#define KSERGEY_Compression_181026121530
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <netbox/utils/string.h>
+
+namespace netbox::utils {
+
+/// Compression format of file
+enum class Compression
+{
+    None,
+    GZip,
+    LZMA,
+    ZSTD,
+    LZ4
+};
+
+/// Number of leading bytes enough to detect compression format
+constexpr std::size_t CompressionMagicSize = 6;
+
+/// Detect compression format by leading bytes of file
+/// @param[in] data is pointer to leading bytes of file
+/// @param[in] size is number of bytes available
+/// @return Compression format, `Compression::None` if unknown
+inline Compression detectCompression(const void* data, std::size_t size) noexcept
+{
+    static constexpr std::uint8_t GZipMagic[] = {0x1f, 0x8b};
+    static constexpr std::uint8_t LZMAMagic[] = {0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00};
+    static constexpr std::uint8_t ZSTDMagic[] = {0x28, 0xb5, 0x2f, 0xfd};
+    static constexpr std::uint8_t LZ4Magic[] = {0x04, 0x22, 0x4d, 0x18};
+
+    auto match = [data, size](const auto& magic) {
+        return size >= sizeof(magic) && std::memcmp(data, magic, sizeof(magic)) == 0;
+    };
+
+    if (match(GZipMagic)) {
+        return Compression::GZip;
+    }
+    if (match(LZMAMagic)) {
+        return Compression::LZMA;
+    }
+    if (match(ZSTDMagic)) {
+        return Compression::ZSTD;
+    }
+    if (match(LZ4Magic)) {
+        return Compression::LZ4;
+    }
+    return Compression::None;
+}
+
+/// Detect compression format by file name suffix
+/// @param[in] filename is path to file
+/// @return Compression format, `Compression::None` if unknown
+inline Compression detectCompression(std::string_view filename) noexcept
+{
+    if (endsWith(filename, ".gz")) {
+        return Compression::GZip;
+    }
+    if (endsWith(filename, ".xz")) {
+        return Compression::LZMA;
+    }
+    if (endsWith(filename, ".zst")) {
+        return Compression::ZSTD;
+    }
+    if (endsWith(filename, ".lz4")) {
+        return Compression::LZ4;
+    }
+    return Compression::None;
+}
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_Compression_181026121530 */
@@ -0,0 +1,107 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_FileChunkConsumer_181026170538
+#define KSERGEY_FileChunkConsumer_181026170538
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <netbox/exception.h>
+#include <netbox/utils/ChunkConsumer.h>
+
+namespace netbox::utils {
+
+/// Write consumed data into file descriptor
+class FileChunkConsumer final
+    : public ChunkConsumer
+{
+private:
+    int fd_{-1};
+
+public:
+    FileChunkConsumer(const FileChunkConsumer&) = delete;
+    FileChunkConsumer& operator=(const FileChunkConsumer&) = delete;
+
+    /// Create (or truncate) file on disk
+    /// @param[in] filename is path to file
+    /// @throw std::runtime_error if file open error
+    explicit FileChunkConsumer(const char* filename)
+    {
+        fd_ = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ == -1) {
+            throwEx< std::runtime_error >(std::string{"File open error ("} + filename + "): " + std::strerror(errno));
+        }
+    }
+
+    /// Destructor
+    ~FileChunkConsumer() noexcept override
+    {
+        ::close(fd_);
+    }
+
+    /// Return native file descriptor
+    int native() const noexcept
+    {
+        return fd_;
+    }
+
+    /// @copydoc ChunkConsumer::consume()
+    /// All chunks are written with as few `writev` calls as possible
+    void consume(const iovec* chunks, std::size_t count) override
+    {
+        while (count > 0) {
+            const int iovcnt = count < IOV_MAX ? int(count) : IOV_MAX;
+            const ssize_t result = ::writev(fd_, chunks, iovcnt);
+            if (result == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throwEx< std::runtime_error >("writev", ErrorCode{errno});
+            }
+
+            // Skip fully written chunks, complete partially written one
+            std::size_t written = result;
+            while (count > 0 && written >= chunks->iov_len) {
+                written -= chunks->iov_len;
+                chunks += 1;
+                count -= 1;
+            }
+            if (written > 0) {
+                write(static_cast< const char* >(chunks->iov_base) + written, chunks->iov_len - written);
+                chunks += 1;
+                count -= 1;
+            }
+        }
+    }
+
+    /// @copydoc ChunkConsumer::finish()
+    void finish() override
+    {}
+
+private:
+    void write(const void* data, std::size_t size)
+    {
+        const char* current = static_cast< const char* >(data);
+        while (size > 0) {
+            const ssize_t result = ::write(fd_, current, size);
+            if (result == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throwEx< std::runtime_error >("write", ErrorCode{errno});
+            }
+            current += result;
+            size -= result;
+        }
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_FileChunkConsumer_181026170538 */
@@ -0,0 +1,130 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_FileChunkProducer_171026131342
+#define KSERGEY_FileChunkProducer_171026131342
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include <netbox/debug.h>
+#include <netbox/utils/ChunkProducer.h>
+
+namespace netbox::utils {
+
+/// Produce raw file content read from file descriptor
+class FileChunkProducer final
+    : public ChunkProducer
+{
+private:
+    int fd_{-1};
+    bool direct_{false};
+
+public:
+    FileChunkProducer(const FileChunkProducer&) = delete;
+    FileChunkProducer& operator=(const FileChunkProducer&) = delete;
+
+    /// Open file from disk
+    /// @param[in] filename is path to file
+    /// @param[in] direct is true to bypass page cache (O_DIRECT),
+    ///     produce buffers should be aligned to `Arena::Alignment` then
+    FileChunkProducer(const char* filename, bool direct = false)
+        : direct_{direct}
+    {
+        fd_ = ::open(filename, O_RDONLY | O_CLOEXEC | (direct ? O_DIRECT : 0));
+        if (fd_ == -1 && direct) {
+            // Filesystem doesn't support O_DIRECT
+            debug("<WARN> Direct IO open error (%s): %s", filename, std::strerror(errno));
+            fd_ = ::open(filename, O_RDONLY | O_CLOEXEC);
+            direct_ = false;
+        }
+        if (fd_ == -1) {
+            debug("<WARN> File open error (%s): %s", filename, std::strerror(errno));
+            return;
+        }
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    /// Destructor
+    ~FileChunkProducer() noexcept override
+    {
+        if (fd_ != -1) {
+            ::close(fd_);
+        }
+    }
+
+    /// Return true if file opened
+    explicit operator bool() const noexcept
+    {
+        return fd_ != -1;
+    }
+
+    /// Return native file descriptor
+    int native() const noexcept
+    {
+        return fd_;
+    }
+
+    /// Set file position for the next produce
+    /// @param[in] offset is offset from the beginning of file
+    /// @return True on success
+    bool seek(off_t offset) noexcept
+    {
+        return ::lseek(fd_, offset, SEEK_SET) == offset;
+    }
+
+    /// Read data at offset, file position is not changed
+    /// @param[in] buffer is pointer to read buffer
+    /// @param[in] size is buffer size
+    /// @param[in] offset is offset from the beginning of file
+    /// @return Bytes read, less than `size` on end of file or error
+    std::size_t readAt(void* buffer, std::size_t size, off_t offset) noexcept
+    {
+        std::size_t result = 0;
+        while (result < size) {
+            const ssize_t count = ::pread(fd_, static_cast< char* >(buffer) + result,
+                    size - result, offset + result);
+            if (count > 0) {
+                result += count;
+                continue;
+            }
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0) {
+                debug("<WARN> File read error: %s", std::strerror(errno));
+            }
+            break;
+        }
+        return result;
+    }
+
+    /// @copydoc ChunkProducer::produce()
+    std::size_t produce(void* buffer, std::size_t size) override
+    {
+        while (true) {
+            const ssize_t result = ::read(fd_, buffer, size);
+            if (NETBOX_LIKELY(result >= 0)) {
+                return result;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EINVAL && direct_) {
+                // Unaligned request, continue through page cache
+                direct_ = false;
+                ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+                continue;
+            }
+            debug("<WARN> File read error: %s", std::strerror(errno));
+            return 0;
+        }
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_FileChunkProducer_171026131342 */
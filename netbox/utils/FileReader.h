@@ -5,14 +5,21 @@
 #ifndef KSERGEY_FileReader_160918003206
 #define KSERGEY_FileReader_160918003206
 
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
+#include <netbox/compiler.h>
 #include <netbox/debug.h>
 #include <netbox/exception.h>
-#include <netbox/utils/string.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
+#include <netbox/utils/Compression.h>
+#include <netbox/utils/FileChunkProducer.h>
+#include <netbox/utils/PipelinedChunkProducer.h>
 
 #if defined( netbox_PCAP_GZIP )
 #   include <netbox/utils/GZipDecompressStream.h>
@@ -22,16 +29,64 @@
 #   include <netbox/utils/LZMADecompressStream.h>
 #endif // defined( netbox_PCAP_LZMA )
 
+#if defined( netbox_PCAP_ZSTD )
+#   include <netbox/utils/ZSTDDecompressStream.h>
+#   include <netbox/utils/ZSTDSeekableDecompressStream.h>
+#endif // defined( netbox_PCAP_ZSTD )
+
+#if defined( netbox_PCAP_LZ4 )
+#   include <netbox/utils/LZ4DecompressStream.h>
+#endif // defined( netbox_PCAP_LZ4 )
+
 namespace netbox::utils {
 
-/// File reader
-/// Could open gzip or lzma encoded files
+/// FileReader tuning
+struct FileReaderOptions
+{
+    /// Size of the read buffer
+    std::size_t bufferSize{1024 * 1024};
+
+    /// Bypass page cache on file reads (O_DIRECT)
+    bool direct{false};
+
+    /// Decompress on a dedicated background thread (compressed files only)
+    bool decompressThread{false};
+
+    /// Number of decompressed chunks the background thread runs ahead
+    std::size_t decompressQueueDepth{4};
+
+    /// Size of decompressed chunk
+    std::size_t decompressChunkSize{4 * 1024 * 1024};
+
+    /// Number of decoder threads (multi-block xz and seekable zstd files only), 0 - number of CPUs
+    unsigned decompressThreads{1};
+
+    /// Memory usage limit of threaded decoder, 0 - quarter of physical memory
+    std::uint64_t decompressMemoryLimit{0};
+};
+
+/// Buffered file reader
+/// Could open gzip, lzma, zstd or lz4 encoded files (detected by magic bytes)
 class FileReader
 {
 private:
-    std::unique_ptr< std::ifstream > fileStream_;
-    std::unique_ptr< std::istream > decodedStream_;
-    std::istream* stream_;
+    /// Minimal read buffer size, enough for any `fetch()` of PCAP record
+    static constexpr std::size_t MinBufferSize = 256 * 1024;
+
+    std::unique_ptr< ChunkProducer > producer_;
+    // Set if reading uncompressed file, allows seek
+    FileChunkProducer* file_{nullptr};
+    // Set if decoding on background thread, its chunks are taken without copying
+    PipelinedChunkProducer* pipeline_{nullptr};
+    Compression compression_{Compression::None};
+    Arena buffer_;
+    // Number of bytes produced before `end_`
+    std::uint64_t offset_{0};
+    // Unread data range inside buffer
+    char* begin_{nullptr};
+    char* end_{nullptr};
+    bool fail_{true};
+    bool eof_{false};
 
 public:
     FileReader(const FileReader&) = delete;
@@ -53,60 +108,98 @@ public:
     }
 
     /// Construct uninitialized FileReader
-    FileReader()
-    {
-        fileStream_ = std::make_unique< std::ifstream >();
-        stream_ = fileStream_.get();
-    }
+    FileReader() = default;
 
     /// Open file from disk
     /// @param[in] filename is path to file
+    /// @param[in] options is reader tuning
     /// @throw std::runtime_error if file open error
-    FileReader(const char* filename)
+    FileReader(const char* filename, const FileReaderOptions& options = {})
     {
-        fileStream_ = std::make_unique< std::ifstream >(filename, std::ios::in | std::ios::binary);
-        if (*fileStream_) {
-            if (endsWith(filename, ".xz")) {
-#if defined( netbox_PCAP_LZMA )
-                decodedStream_ = std::make_unique< LZMADecompressStream >(*fileStream_);
-#else // defined( netbox_PCAP_LZMA )
-                throwEx< std::runtime_error >("LZMA not supported");
-#endif // defined( netbox_PCAP_LZMA )
-            } else if (endsWith(filename, ".gz")) {
+        auto file = std::make_unique< FileChunkProducer >(filename, options.direct);
+        if (!*file) {
+            return;
+        }
+
+        std::unique_ptr< ChunkProducer > decoder;
+        compression_ = detectCompression(filename, *file);
+        switch (compression_) {
+            case Compression::GZip:
 #if defined( netbox_PCAP_GZIP )
-                decodedStream_ = std::make_unique< GZipDecompressStream >(*fileStream_);
+                decoder = std::make_unique< GZipDecompressStream >(std::move(file));
 #else // defined( netbox_PCAP_GZIP )
                 throwEx< std::runtime_error >("GZip not supported");
 #endif // defined( netbox_PCAP_GZIP )
-            }
+                break;
+            case Compression::LZMA:
+#if defined( netbox_PCAP_LZMA )
+                decoder = std::make_unique< LZMADecompressStream >(std::move(file),
+                        options.decompressThreads, options.decompressMemoryLimit);
+#else // defined( netbox_PCAP_LZMA )
+                throwEx< std::runtime_error >("LZMA not supported");
+#endif // defined( netbox_PCAP_LZMA )
+                break;
+            case Compression::ZSTD:
+#if defined( netbox_PCAP_ZSTD )
+                decoder = openZSTD(filename, std::move(file), options);
+#else // defined( netbox_PCAP_ZSTD )
+                throwEx< std::runtime_error >("ZSTD not supported");
+#endif // defined( netbox_PCAP_ZSTD )
+                break;
+            case Compression::LZ4:
+#if defined( netbox_PCAP_LZ4 )
+                decoder = std::make_unique< LZ4DecompressStream >(std::move(file));
+#else // defined( netbox_PCAP_LZ4 )
+                throwEx< std::runtime_error >("LZ4 not supported");
+#endif // defined( netbox_PCAP_LZ4 )
+                break;
+            case Compression::None:
+                break;
+        }
+
+        if (decoder) {
+            openDecoder(std::move(decoder), options);
         } else {
-            debug("<WARN> File open error (%s)", filename);
+            file_ = file.get();
+            attach(std::move(file), options.bufferSize);
         }
+    }
 
-        stream_ = decodedStream_
-            ? decodedStream_.get()
-            : fileStream_.get();
+    /// Construct reader of data produced by decoder
+    /// @param[in] decoder is producer of data
+    /// @param[in] options is reader tuning, `decompressThread` applies to `decoder`
+    /// @param[in] offset is offset of the first byte produced (as reported by `tell()`),
+    ///     non-zero if decoder starts in the middle of a stream
+    /// @param[in] compression is compression format decoded by `decoder`
+    FileReader(std::unique_ptr< ChunkProducer > decoder, const FileReaderOptions& options = {},
+            std::uint64_t offset = 0, Compression compression = Compression::None)
+    {
+        if (decoder) {
+            openDecoder(std::move(decoder), options);
+            offset_ = offset;
+            compression_ = compression;
+        }
     }
 
     /// Destructor
-    virtual ~FileReader() noexcept = default;
+    ~FileReader() noexcept = default;
 
     /// Return true if file still readable
     explicit operator bool() const noexcept
     {
-        return stream_->operator bool();
+        return !fail_;
     }
 
     /// Return true if stream good
     bool good() const noexcept
     {
-        return stream_->good();
+        return !fail_ && !eof_;
     }
 
     /// Return true if end of file reached
     bool eof() const noexcept
     {
-        return stream_->eof();
+        return eof_;
     }
 
     /// Read data from file
@@ -115,8 +208,12 @@ public:
     /// @return Bytes read
     std::size_t read(void* buffer, std::size_t size)
     {
-        stream_->read(reinterpret_cast< char* >(buffer), size);
-        return stream_->gcount();
+        if (NETBOX_LIKELY(std::size_t(end_ - begin_) >= size)) {
+            std::memcpy(buffer, begin_, size);
+            begin_ += size;
+            return size;
+        }
+        return readSlow(static_cast< char* >(buffer), size);
     }
 
     /// Read plain struct from file
@@ -130,12 +227,228 @@ public:
         return read(&s, sizeof(s));
     }
 
+    /// Skip data of file
+    /// @param[in] size is number of bytes to skip
+    /// @return Bytes skipped
+    std::size_t skip(std::size_t size)
+    {
+        std::size_t result = 0;
+        while (result < size) {
+            if (begin_ == end_ && !refill(1)) {
+                break;
+            }
+            const std::size_t count = std::min(size - result, std::size_t(end_ - begin_));
+            begin_ += count;
+            result += count;
+        }
+        return result;
+    }
+
+    /// Return true if reader supports `seek()` (uncompressed file)
+    bool seekable() const noexcept
+    {
+        return file_ != nullptr;
+    }
+
+    /// Return compression format of the file being read
+    Compression compression() const noexcept
+    {
+        return compression_;
+    }
+
+    /// Return offset of the next byte to read (of decompressed data)
+    std::uint64_t tell() const noexcept
+    {
+        return offset_ - std::size_t(end_ - begin_);
+    }
+
+    /// Set offset of the next byte to read
+    /// @param[in] offset is offset from the beginning of file
+    /// @return True on success
+    /// @pre `seekable()`
+    bool seek(std::uint64_t offset)
+    {
+        // Keep reads aligned (O_DIRECT)
+        const std::uint64_t aligned = offset & ~std::uint64_t(Arena::Alignment - 1);
+        if (!file_ || !file_->seek(aligned)) {
+            return false;
+        }
+        begin_ = end_ = buffer_.data();
+        offset_ = aligned;
+        fail_ = eof_ = false;
+        return skip(offset - aligned) == offset - aligned;
+    }
+
+    /// Read data from file without copying
+    /// @param[in] size is number of bytes to read
+    /// @return Pointer to data inside reader buffer, valid until next read,
+    ///     `nullptr` if not enough data available
+    const void* fetch(std::size_t size)
+    {
+        if (NETBOX_UNLIKELY(std::size_t(end_ - begin_) < size)) {
+            if (!refill(size)) {
+                return nullptr;
+            }
+        }
+        const char* result = begin_;
+        begin_ += size;
+        return result;
+    }
+
+    /// Return data available to read without consuming it
+    /// @param[in] size is number of bytes to peek
+    /// @return Pointer to data inside reader buffer, valid until next read,
+    ///     `nullptr` if not enough data available
+    const void* peek(std::size_t size)
+    {
+        if (NETBOX_UNLIKELY(std::size_t(end_ - begin_) < size)) {
+            if (!refill(size)) {
+                return nullptr;
+            }
+        }
+        return begin_;
+    }
+
     /// Swap FileReader internals with other instance
     void swap(FileReader& other) noexcept
     {
-        fileStream_.swap(other.fileStream_);
-        decodedStream_.swap(other.decodedStream_);
-        std::swap(stream_, other.stream_);
+        producer_.swap(other.producer_);
+        std::swap(file_, other.file_);
+        std::swap(pipeline_, other.pipeline_);
+        std::swap(compression_, other.compression_);
+        std::swap(buffer_, other.buffer_);
+        std::swap(offset_, other.offset_);
+        std::swap(begin_, other.begin_);
+        std::swap(end_, other.end_);
+        std::swap(fail_, other.fail_);
+        std::swap(eof_, other.eof_);
+    }
+
+private:
+    /// Detect compression by magic bytes, by suffix if file too short
+    static Compression detectCompression(const char* filename, FileChunkProducer& file)
+    {
+        // Aligned read, file could be opened with O_DIRECT
+        Arena magic{Arena::Alignment};
+        if (file.readAt(magic.data(), magic.size(), 0) >= CompressionMagicSize) {
+            return utils::detectCompression(magic.data(), CompressionMagicSize);
+        }
+        return utils::detectCompression(filename);
+    }
+
+#if defined( netbox_PCAP_ZSTD )
+    /// Open seekable format file for parallel decoding, streaming decoder otherwise
+    static std::unique_ptr< ChunkProducer > openZSTD(const char* filename,
+            std::unique_ptr< FileChunkProducer > file, const FileReaderOptions& options)
+    {
+        if (options.decompressThreads != 1) {
+            // Frames are read at random offsets, through page cache
+            auto seekable = std::make_unique< FileChunkProducer >(filename);
+            auto frames = ZSTDSeekableDecompressStream::readSeekTable(*seekable);
+            if (!frames.empty()) {
+                return std::make_unique< ZSTDSeekableDecompressStream >(std::move(seekable),
+                        std::move(frames), options.decompressThreads);
+            }
+        }
+        return std::make_unique< ZSTDDecompressStream >(std::move(file));
+    }
+#endif // defined( netbox_PCAP_ZSTD )
+
+    void openDecoder(std::unique_ptr< ChunkProducer > decoder, const FileReaderOptions& options)
+    {
+        if (options.decompressThread) {
+            // Unread data is kept in front of a chunk, as much as read buffer holds
+            auto pipeline = std::make_unique< PipelinedChunkProducer >(std::move(decoder),
+                    options.decompressQueueDepth, options.decompressChunkSize,
+                    std::max(options.bufferSize, MinBufferSize));
+            pipeline_ = pipeline.get();
+            decoder = std::move(pipeline);
+        }
+        attach(std::move(decoder), options.bufferSize);
+    }
+
+    void attach(std::unique_ptr< ChunkProducer > producer, std::size_t bufferSize)
+    {
+        producer_ = std::move(producer);
+        begin_ = end_ = buffer_.reserve(std::max(bufferSize, MinBufferSize));
+        fail_ = false;
+    }
+
+    std::size_t readSlow(char* buffer, std::size_t size)
+    {
+        std::size_t result = 0;
+        while (result < size) {
+            if (begin_ == end_ && !refill(1)) {
+                break;
+            }
+            const std::size_t count = std::min(size - result, std::size_t(end_ - begin_));
+            std::memcpy(buffer + result, begin_, count);
+            begin_ += count;
+            result += count;
+        }
+        return result;
+    }
+
+    /// Make at least `size` bytes available in buffer
+    bool refill(std::size_t size)
+    {
+        if (NETBOX_UNLIKELY(fail_ || eof_)) {
+            return false;
+        }
+        if (pipeline_) {
+            return exchange(size);
+        }
+
+        char* base = buffer_.data();
+        const std::size_t unread = end_ - begin_;
+
+        // Keep unread tail just before aligned position, so reads are
+        // always issued at aligned address (required by O_DIRECT)
+        const std::size_t offset = (unread + Arena::Alignment - 1) & ~(Arena::Alignment - 1);
+        if (NETBOX_UNLIKELY(offset + size - unread > buffer_.size())) {
+            debug("<WARN> Read of %zu bytes exceeds buffer size", size);
+            fail_ = eof_ = true;
+            return false;
+        }
+        std::memmove(base + offset - unread, begin_, unread);
+        begin_ = base + offset - unread;
+        end_ = base + offset;
+
+        while (std::size_t(end_ - begin_) < size) {
+            char* const limit = base + buffer_.size();
+            const std::size_t count = producer_->produce(end_, limit - end_);
+            if (count == 0) {
+                fail_ = eof_ = true;
+                return false;
+            }
+            end_ += count;
+            offset_ += count;
+        }
+
+        return true;
+    }
+
+    /// Make at least `size` bytes available taking chunks of background thread,
+    /// unread data is moved in front of each chunk
+    bool exchange(std::size_t size)
+    {
+        while (std::size_t(end_ - begin_) < size) {
+            const std::size_t unread = end_ - begin_;
+            if (NETBOX_UNLIKELY(unread > pipeline_->headroom())) {
+                debug("<WARN> Read of %zu bytes exceeds buffer size", size);
+                fail_ = eof_ = true;
+                return false;
+            }
+            const std::size_t count = pipeline_->exchange(buffer_, begin_, unread);
+            if (count == 0) {
+                fail_ = eof_ = true;
+                return false;
+            }
+            end_ = buffer_.data() + pipeline_->headroom() + count;
+            begin_ = end_ - count - unread;
+            offset_ += count;
+        }
+        return true;
     }
 };
 
@@ -0,0 +1,259 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_FileWriter_181026172744
+#define KSERGEY_FileWriter_181026172744
+
+#include <sys/uio.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <netbox/compiler.h>
+#include <netbox/debug.h>
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkConsumer.h>
+#include <netbox/utils/Compression.h>
+#include <netbox/utils/FileChunkConsumer.h>
+#include <netbox/utils/PipelinedChunkConsumer.h>
+
+#if defined( netbox_PCAP_GZIP )
+#   include <netbox/utils/GZipCompressStream.h>
+#endif // defined( netbox_PCAP_GZIP )
+
+#if defined( netbox_PCAP_ZSTD )
+#   include <netbox/utils/ZSTDCompressStream.h>
+#endif // defined( netbox_PCAP_ZSTD )
+
+namespace netbox::utils {
+
+/// FileWriter tuning
+struct FileWriterOptions
+{
+    /// Size of write buffer
+    std::size_t bufferSize{1024 * 1024};
+
+    /// Compression level, 0 - library default
+    int compressLevel{0};
+
+    /// Compress on a background thread
+    bool compressThread{false};
+
+    /// Number of chunks queued to compression thread
+    std::size_t compressQueueDepth{4};
+
+    /// Size of each chunk queued to compression thread
+    std::size_t compressChunkSize{4 * 1024 * 1024};
+};
+
+/// Buffered file writer
+/// Could write gzip or zstd encoded files (selected by file name suffix)
+class FileWriter
+{
+private:
+    std::unique_ptr< ChunkConsumer > consumer_;
+    Arena buffer_;
+    // Number of bytes consumed before `begin_`
+    std::uint64_t offset_{0};
+    // Free space inside buffer
+    char* begin_{nullptr};
+    char* end_{nullptr};
+
+public:
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    /// Move constructor
+    FileWriter(FileWriter&& other) noexcept
+    {
+        swap(other);
+    }
+
+    /// Move operator, closes the current file
+    FileWriter& operator=(FileWriter&& other)
+    {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /// Construct uninitialized FileWriter
+    FileWriter() = default;
+
+    /// Create (or truncate) file on disk
+    /// @param[in] filename is path to file
+    /// @param[in] options is writer tuning
+    /// @throw std::runtime_error if file open error
+    FileWriter(const char* filename, const FileWriterOptions& options = {})
+    {
+        std::unique_ptr< ChunkConsumer > file = std::make_unique< FileChunkConsumer >(filename);
+
+        std::unique_ptr< ChunkConsumer > encoder;
+        switch (detectCompression(filename)) {
+            case Compression::GZip:
+#if defined( netbox_PCAP_GZIP )
+                encoder = std::make_unique< GZipCompressStream >(std::move(file), options.compressLevel);
+#else // defined( netbox_PCAP_GZIP )
+                throwEx< std::runtime_error >("GZip not supported");
+#endif // defined( netbox_PCAP_GZIP )
+                break;
+            case Compression::ZSTD:
+#if defined( netbox_PCAP_ZSTD )
+                encoder = std::make_unique< ZSTDCompressStream >(std::move(file), options.compressLevel);
+#else // defined( netbox_PCAP_ZSTD )
+                throwEx< std::runtime_error >("ZSTD not supported");
+#endif // defined( netbox_PCAP_ZSTD )
+                break;
+            case Compression::LZMA:
+            case Compression::LZ4:
+                throwEx< std::runtime_error >("Compression not supported for writing");
+            case Compression::None:
+                break;
+        }
+
+        if (encoder) {
+            if (options.compressThread) {
+                encoder = std::make_unique< PipelinedChunkConsumer >(std::move(encoder),
+                        options.compressQueueDepth, options.compressChunkSize);
+            }
+            attach(std::move(encoder), options.bufferSize);
+        } else {
+            attach(std::move(file), options.bufferSize);
+        }
+    }
+
+    /// Construct writer of data consumed by encoder
+    /// @param[in] encoder is consumer of data
+    /// @param[in] options is writer tuning
+    FileWriter(std::unique_ptr< ChunkConsumer > encoder, const FileWriterOptions& options = {})
+    {
+        if (encoder) {
+            attach(std::move(encoder), options.bufferSize);
+        }
+    }
+
+    /// Destructor, closes the file
+    ~FileWriter() noexcept
+    {
+        try {
+            close();
+        } catch (const std::exception& e) {
+            debug("<WARN> File close error: %s", e.what());
+        }
+    }
+
+    /// Return true if file open
+    explicit operator bool() const noexcept
+    {
+        return consumer_ != nullptr;
+    }
+
+    /// Write data into file
+    /// @param[in] data is pointer to data
+    /// @param[in] size is data size
+    /// @throw std::runtime_error on write error
+    /// @pre `*this`
+    void write(const void* data, std::size_t size)
+    {
+        if (NETBOX_LIKELY(std::size_t(end_ - begin_) >= size)) {
+            std::memcpy(begin_, data, size);
+            begin_ += size;
+            return;
+        }
+        writeSlow(data, size);
+    }
+
+    /// Write plain struct into file
+    /// @param[in] s is reference to struct
+    /// @pre `std::is_trivially_copyable< T >`
+    template< class T >
+    void writeStruct(const T& s)
+    {
+        static_assert( std::is_trivially_copyable< T >(), "Non trivially copyable type" );
+        write(&s, sizeof(s));
+    }
+
+    /// Return number of bytes written (of uncompressed data)
+    std::uint64_t tell() const noexcept
+    {
+        return offset_ + std::size_t(begin_ - buffer_.data());
+    }
+
+    /// Pass buffered data to the file (or encoder)
+    /// @throw std::runtime_error on write error
+    void flush()
+    {
+        const iovec chunk{buffer_.data(), std::size_t(begin_ - buffer_.data())};
+        if (chunk.iov_len > 0) {
+            consume(&chunk, 1);
+        }
+    }
+
+    /// Write buffered data, complete encoded stream and close the file
+    /// @throw std::runtime_error on write error
+    void close()
+    {
+        if (!consumer_) {
+            return;
+        }
+        auto consumer = std::move(consumer_);
+        const iovec chunk{buffer_.data(), std::size_t(begin_ - buffer_.data())};
+        offset_ += chunk.iov_len;
+        begin_ = end_ = buffer_.data();
+        if (chunk.iov_len > 0) {
+            consumer->consume(&chunk, 1);
+        }
+        consumer->finish();
+    }
+
+    /// Swap FileWriter internals with other instance
+    void swap(FileWriter& other) noexcept
+    {
+        consumer_.swap(other.consumer_);
+        std::swap(buffer_, other.buffer_);
+        std::swap(offset_, other.offset_);
+        std::swap(begin_, other.begin_);
+        std::swap(end_, other.end_);
+    }
+
+private:
+    void attach(std::unique_ptr< ChunkConsumer > consumer, std::size_t bufferSize)
+    {
+        consumer_ = std::move(consumer);
+        begin_ = buffer_.reserve(std::max< std::size_t >(bufferSize, 1));
+        end_ = begin_ + buffer_.size();
+    }
+
+    /// Buffered data and the new data are written with a single `writev`,
+    /// the buffer becomes empty
+    void writeSlow(const void* data, std::size_t size)
+    {
+        const iovec chunks[2] = {
+            {buffer_.data(), std::size_t(begin_ - buffer_.data())},
+            {const_cast< void* >(data), size}
+        };
+        consume(chunks, 2);
+    }
+
+    void consume(const iovec* chunks, std::size_t count)
+    {
+        // Buffer is reset even on error, the data is lost anyway
+        begin_ = buffer_.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            offset_ += chunks[i].iov_len;
+        }
+        consumer_->consume(chunks, count);
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_FileWriter_181026172744 */
@@ -0,0 +1,122 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_GZipCompressStream_181026171102
+#define KSERGEY_GZipCompressStream_181026171102
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <zlib.h>
+
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkConsumer.h>
+
+namespace netbox::utils {
+
+/// Compress consumed data into GZip format
+class GZipCompressStream final
+    : public ChunkConsumer
+{
+private:
+    static constexpr std::size_t BufferSize = 256 * 1024;
+
+    // The consumer of compressed data
+    std::unique_ptr< ChunkConsumer > output_;
+
+    // Buffer for compressed data
+    Arena outputBuffer_{BufferSize};
+
+    // ZLIB stream
+    z_stream zStream_;
+
+public:
+    GZipCompressStream(const GZipCompressStream&) = delete;
+    GZipCompressStream& operator=(const GZipCompressStream&) = delete;
+
+    /// Creates a compressor writes compressed data into the given consumer
+    /// @param[in] output is consumer of compressed data
+    /// @param[in] level is compression level (1..9), 0 - library default
+    GZipCompressStream(std::unique_ptr< ChunkConsumer > output, int level = 0)
+        : output_{std::move(output)}
+    {
+        std::memset(&zStream_, 0, sizeof(zStream_));
+        if (deflateInit2(&zStream_, level == 0 ? Z_DEFAULT_COMPRESSION : level,
+                    Z_DEFLATED, MAX_WBITS | 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throwEx< std::runtime_error >("GZip encoder error");
+        }
+        resetOutput();
+    }
+
+    /// Destructor
+    ~GZipCompressStream() noexcept override
+    {
+        deflateEnd(&zStream_);
+    }
+
+    /// @copydoc ChunkConsumer::consume()
+    void consume(const iovec* chunks, std::size_t count) override
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            const Bytef* data = static_cast< const Bytef* >(chunks[i].iov_base);
+            std::size_t size = chunks[i].iov_len;
+            while (size > 0) {
+                const uInt avail = std::min< std::size_t >(size, UINT_MAX);
+                zStream_.next_in = const_cast< Bytef* >(data);
+                zStream_.avail_in = avail;
+                while (zStream_.avail_in > 0) {
+                    compress(Z_NO_FLUSH);
+                }
+                data += avail;
+                size -= avail;
+            }
+        }
+    }
+
+    /// @copydoc ChunkConsumer::finish()
+    void finish() override
+    {
+        zStream_.next_in = nullptr;
+        zStream_.avail_in = 0;
+        while (compress(Z_FINISH) != Z_STREAM_END)
+        {}
+        writeOutput();
+        output_->finish();
+    }
+
+private:
+    /// Run compression step, write compressed data when output buffer full
+    int compress(int flush)
+    {
+        const int rc = deflate(&zStream_, flush);
+        if (NETBOX_UNLIKELY(rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR)) {
+            throwEx< std::runtime_error >("GZip encoder error");
+        }
+        if (zStream_.avail_out == 0) {
+            writeOutput();
+        }
+        return rc;
+    }
+
+    void writeOutput()
+    {
+        const iovec chunk{outputBuffer_.data(), outputBuffer_.size() - zStream_.avail_out};
+        if (chunk.iov_len > 0) {
+            output_->consume(&chunk, 1);
+        }
+        resetOutput();
+    }
+
+    void resetOutput() noexcept
+    {
+        zStream_.next_out = reinterpret_cast< Bytef* >(outputBuffer_.data());
+        zStream_.avail_out = outputBuffer_.size();
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_GZipCompressStream_181026171102 */
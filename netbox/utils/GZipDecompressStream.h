@@ -5,133 +5,155 @@
 #ifndef KSERGEY_GZipDecompressStream_160918003633
 #define KSERGEY_GZipDecompressStream_160918003633
 
+#include <algorithm>
 #include <cstring>
-#include <istream>
-#include <streambuf>
+#include <memory>
 #include <zlib.h>
 
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
+
 namespace netbox::utils {
-namespace details {
 
-/// The GZip streambuffer that decompresses data
-class GZipDecompressStreamBuffer final
-    : public std::basic_streambuf< char >
+/// Produce data decompressed from GZip encoded input
+/// Concatenated GZip members are decoded as a single stream
+class GZipDecompressStream final
+    : public ChunkProducer
 {
 private:
-    using off_type = std::basic_istream< char >::off_type;
+    static constexpr std::size_t BufferSize = 256 * 1024;
 
-    static constexpr std::size_t BufferSize = 4096;
+    /// Size of GZip member trailer (CRC32 and ISIZE)
+    static constexpr std::size_t TrailerSize = 8;
 
-    // The stream to read the compressed data from
-    std::basic_istream< char >& inputStream_;
+    // The producer of compressed data
+    std::unique_ptr< ChunkProducer > input_;
 
     // Buffer for compressed data
-    char inputBuffer_[BufferSize];
-
-    // Buffer for uncompressed data
-    char outputBuffer_[BufferSize];
+    Arena inputBuffer_{BufferSize};
 
     // ZLIB stream
     z_stream zStream_;
 
-    // The return value for ZLIB
-    int error_;
+    // Whether decoding raw deflate data (resumed inside GZip member)
+    bool raw_{false};
+
+    // Whether the end of GZip member reached
+    bool memberDone_{false};
+
+    // Number of input bytes to skip before next member
+    std::size_t skip_{0};
+
+    // Whether all output has been produced
+    bool outputDone_{false};
 
 public:
-    GZipDecompressStreamBuffer(std::basic_istream< char >& inputStream)
-        : inputStream_{inputStream}
-    {
-        std::memset(&zStream_, 0, sizeof(zStream_));
-        error_ = inflateInit2(&zStream_, MAX_WBITS | 16);
-        setg(outputBuffer_ + 4, outputBuffer_ + 4, outputBuffer_ + 4);
-    }
+    GZipDecompressStream(const GZipDecompressStream&) = delete;
+    GZipDecompressStream& operator=(const GZipDecompressStream&) = delete;
 
-    virtual ~GZipDecompressStreamBuffer() noexcept
+    /// Creates a decompressor reads compressed data from the given producer
+    GZipDecompressStream(std::unique_ptr< ChunkProducer > input)
+        : input_{std::move(input)}
     {
-        inflateEnd(&zStream_);
+        std::memset(&zStream_, 0, sizeof(zStream_));
+        if (inflateInit2(&zStream_, MAX_WBITS | 16) != Z_OK) {
+            throwEx< std::runtime_error >("GZip decoder error");
+        }
     }
 
-protected:
-    int_type underflow() override
+    /// Creates a decompressor resumed at deflate block boundary inside GZip member
+    /// @param[in] input is producer of compressed data starting at the byte holding
+    ///     `bits` unused bits of the boundary (or at the boundary if `bits` is 0)
+    /// @param[in] bits is number of bits of the first input byte to decode
+    /// @param[in] window is data decompressed before the boundary (up to 32KiB)
+    /// @param[in] windowSize is size of `window`
+    GZipDecompressStream(std::unique_ptr< ChunkProducer > input, int bits,
+            const void* window, std::size_t windowSize)
+        : input_{std::move(input)}
+        , raw_{true}
     {
-        if (gptr() && (gptr() < egptr())) {
-            return *reinterpret_cast< std::uint8_t* >(gptr());
-        }
-
-        int count = int(gptr() - eback());
-        if (count > 4) {
-            count = 4;
+        std::memset(&zStream_, 0, sizeof(zStream_));
+        if (inflateInit2(&zStream_, -MAX_WBITS) != Z_OK) {
+            throwEx< std::runtime_error >("GZip decoder error");
         }
-        std::memcpy(outputBuffer_ + (4 - count), gptr() - count, count);
 
-        const int size = unzipFromStream(outputBuffer_ + 4, BufferSize - 4);
-        if (size <= 0) {
-            return traits_type::eof();
+        if (bits) {
+            if (!fillInputBuffer()) {
+                throwEx< std::runtime_error >("GZip decoder couldn't resume decompression");
+            }
+            const int value = zStream_.next_in[0] >> (8 - bits);
+            zStream_.next_in += 1;
+            zStream_.avail_in -= 1;
+            inflatePrime(&zStream_, bits, value);
         }
 
-        setg(outputBuffer_ + (4 - count), outputBuffer_ + 4, outputBuffer_ + (4 + size));
-
-        return *reinterpret_cast< std::uint8_t* >(gptr());
+        inflateSetDictionary(&zStream_, static_cast< const Bytef* >(window), windowSize);
     }
 
-private:
-    std::size_t fillInputBuffer()
+    /// Cleans the zlib decompressor
+    ~GZipDecompressStream() noexcept override
     {
-        zStream_.next_in = reinterpret_cast< std::uint8_t* >(inputBuffer_);
-        inputStream_.read(inputBuffer_, BufferSize);
-        zStream_.avail_in = inputStream_.gcount();
-        return zStream_.avail_in;
+        inflateEnd(&zStream_);
     }
 
-    std::size_t unzipFromStream(char* buf, std::size_t size)
+    /// @copydoc ChunkProducer::produce()
+    std::size_t produce(void* buffer, std::size_t size) override
     {
-        zStream_.next_out = reinterpret_cast< std::uint8_t* >(buf);
+        if (outputDone_) {
+            return 0;
+        }
+
+        zStream_.next_out = static_cast< Bytef* >(buffer);
         zStream_.avail_out = size;
-        std::size_t count = zStream_.avail_in;
 
-        do {
-            if (!zStream_.avail_in) {
-                count = fillInputBuffer();
+        while (zStream_.avail_out) {
+            if (zStream_.avail_in == 0 && !fillInputBuffer()) {
+                outputDone_ = true;
+                break;
             }
-            if (zStream_.avail_in) {
-                error_ = inflate(&zStream_, Z_SYNC_FLUSH);
+
+            if (skip_) {
+                const std::size_t count = std::min< std::size_t >(skip_, zStream_.avail_in);
+                zStream_.next_in += count;
+                zStream_.avail_in -= count;
+                skip_ -= count;
+                continue;
             }
-        } while (error_ == Z_OK && zStream_.avail_out && count);
 
-        const std::size_t readBytes = size - zStream_.avail_out;
+            if (memberDone_) {
+                // Next GZip member expected, anything else is trailing garbage
+                if (zStream_.next_in[0] != 0x1f) {
+                    outputDone_ = true;
+                    break;
+                }
+                inflateReset2(&zStream_, MAX_WBITS | 16);
+                memberDone_ = false;
+            }
 
-        if (error_ == Z_STREAM_END) {
-            if (zStream_.avail_in) {
-                inputStream_.clear(std::ios::goodbit);
-                inputStream_.seekg(-off_type(zStream_.avail_in), std::ios_base::cur);
-                zStream_.avail_in = 0;
+            const int result = inflate(&zStream_, Z_NO_FLUSH);
+            if (result == Z_STREAM_END) {
+                if (raw_) {
+                    // Raw inflate leaves member trailer unread
+                    skip_ = TrailerSize;
+                    raw_ = false;
+                }
+                memberDone_ = true;
+            } else if (result != Z_OK && result != Z_BUF_ERROR) {
+                throwEx< std::runtime_error >("GZip decoder couldn't decompress data");
             }
         }
 
-        return readBytes;
+        return size - zStream_.avail_out;
     }
-};
-
-} /* namespace details */
 
-/// A stream that reads compressed data from the underlying stream,
-/// and provides the decompressed data
-class GZipDecompressStream final
-    : public std::basic_istream< char >
-{
 private:
-    // The streambuffer responsible for the actual decompression
-    details::GZipDecompressStreamBuffer streamBuffer_;
-
-public:
-    /// Creates a decompression reads compressed data from the given stream, and provides decompressed data
-    GZipDecompressStream(std::basic_istream< char >& streamBuffer)
-        : basic_istream< char >(&streamBuffer_)
-        , streamBuffer_(streamBuffer)
-    {}
-
-    virtual ~GZipDecompressStream() noexcept
-    {}
+    std::size_t fillInputBuffer()
+    {
+        zStream_.next_in = reinterpret_cast< Bytef* >(inputBuffer_.data());
+        zStream_.avail_in = input_->produce(inputBuffer_.data(), inputBuffer_.size());
+        return zStream_.avail_in;
+    }
 };
 
 } /* namespace netbox::utils */
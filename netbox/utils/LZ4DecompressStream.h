@@ -0,0 +1,108 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_LZ4DecompressStream_181026122342
+#define KSERGEY_LZ4DecompressStream_181026122342
+
+#include <memory>
+#include <lz4frame.h>
+
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
+
+namespace netbox::utils {
+
+/// Produce data decompressed from LZ4 frame encoded input
+/// Concatenated frames are decoded one after another.
+class LZ4DecompressStream final
+    : public ChunkProducer
+{
+private:
+    static constexpr std::size_t BufferSize = 1024 * 1024;
+
+    struct Deleter
+    {
+        void operator()(LZ4F_dctx* context) const noexcept
+        {
+            LZ4F_freeDecompressionContext(context);
+        }
+    };
+
+    // The producer of compressed data
+    std::unique_ptr< ChunkProducer > input_;
+
+    // Buffer for compressed data
+    Arena inputBuffer_{BufferSize};
+    const char* inputBegin_{nullptr};
+    const char* inputEnd_{nullptr};
+
+    // Whether the current frame is complete
+    bool frameDone_{true};
+
+    // Whether all output has been produced
+    bool outputDone_{false};
+
+    // The actual decompressor
+    std::unique_ptr< LZ4F_dctx, Deleter > context_;
+
+public:
+    LZ4DecompressStream(const LZ4DecompressStream&) = delete;
+    LZ4DecompressStream& operator=(const LZ4DecompressStream&) = delete;
+
+    /// Creates a decompressor reads compressed data from the given producer
+    /// @throw std::runtime_error on decoder initialization error
+    LZ4DecompressStream(std::unique_ptr< ChunkProducer > input)
+        : input_{std::move(input)}
+    {
+        LZ4F_dctx* context = nullptr;
+        if (LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION))) {
+            throwEx< std::runtime_error >("LZ4 decoder error");
+        }
+        context_.reset(context);
+    }
+
+    /// @copydoc ChunkProducer::produce()
+    /// @throw std::runtime_error on corrupted or truncated input
+    std::size_t produce(void* buffer, std::size_t size) override
+    {
+        if (outputDone_) {
+            return 0;
+        }
+
+        char* out = static_cast< char* >(buffer);
+        char* const outEnd = out + size;
+
+        while (out != outEnd) {
+            if (inputBegin_ == inputEnd_) {
+                inputBegin_ = inputBuffer_.data();
+                inputEnd_ = inputBegin_ + input_->produce(inputBuffer_.data(), inputBuffer_.size());
+                if (inputBegin_ == inputEnd_) {
+                    if (!frameDone_) {
+                        throwEx< std::runtime_error >("LZ4 truncated input");
+                    }
+                    outputDone_ = true;
+                    break;
+                }
+            }
+
+            std::size_t outSize = outEnd - out;
+            std::size_t inSize = inputEnd_ - inputBegin_;
+            const std::size_t result = LZ4F_decompress(context_.get(), out, &outSize,
+                    inputBegin_, &inSize, nullptr);
+            if (LZ4F_isError(result)) {
+                throwEx< std::runtime_error >("LZ4 decoder couldn't decompress data");
+            }
+            out += outSize;
+            inputBegin_ += inSize;
+            frameDone_ = result == 0;
+        }
+
+        return out - static_cast< char* >(buffer);
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_LZ4DecompressStream_181026122342 */
@@ -5,161 +5,134 @@
 #ifndef KSERGEY_LZMADecompressStream_160918003744
 #define KSERGEY_LZMADecompressStream_160918003744
 
+#include <algorithm>
 #include <cstdint>
-#include <istream>
 #include <limits>
-#include <streambuf>
+#include <memory>
 #include <lzma.h>
 
 #include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
 
 namespace netbox::utils {
-namespace details {
 
-/// The XZ (LZMA) streambuffer that decompresses data
-class LZMADecompressStreamBuffer final
-    : public std::basic_streambuf< char >
+/// Produce data decompressed from XZ (LZMA) encoded input
+/// Multi-block files (e.g. made by `xz -T`) could be decoded by several threads,
+/// single-block files and blocks too large for the memory limit are decoded
+/// by one thread.
+class LZMADecompressStream final
+    : public ChunkProducer
 {
+public:
+    /// Threaded decoding available (liblzma >= 5.4.0)
+#if LZMA_VERSION >= 50040002
+    static constexpr bool ThreadsSupported = true;
+#else // LZMA_VERSION >= 50040002
+    static constexpr bool ThreadsSupported = false;
+#endif // LZMA_VERSION >= 50040002
+
 private:
     static constexpr std::uint32_t DecoderFlags = LZMA_TELL_UNSUPPORTED_CHECK | LZMA_CONCATENATED;
     static constexpr std::uint64_t MemoryLimit = std::numeric_limits< std::uint64_t >::max();
-    static constexpr std::size_t BufferSize = 4096;
+    static constexpr std::size_t BufferSize = 1024 * 1024;
 
-    // The stream to read the compressed data from
-    std::basic_istream< char >& inputStream_;
+    // The producer of compressed data
+    std::unique_ptr< ChunkProducer > input_;
 
     // Buffer for compressed data
-    char inputBuffer_[BufferSize];
-
-    // Buffer for uncompressed data
-    char outputBuffer_[BufferSize];
-
-    // Number of bytes of the input buffer that are used
-    std::size_t inputLength_{0};
+    Arena inputBuffer_{BufferSize};
 
-    // Number of bytes of the output buffer that are used
-    std::size_t outputLength_{0};
-
-    // Whether an eof is encountered on the input stream
+    // Whether an eof is encountered on the input
     bool inputDone_{false};
 
-    // Whether all output has been read
+    // Whether all output has been produced
     bool outputDone_{false};
 
-    // The return value for XZ
-    lzma_ret xzResult_;
-
-    // What the decompressor should do
-    lzma_action xzAction_;
-
     // The actual decompressor
-    lzma_stream xzStream_;
+    lzma_stream xzStream_ = LZMA_STREAM_INIT;
 
 public:
-    /// Creates a streambuffer that reads compressed data from the given stream
-    LZMADecompressStreamBuffer(std::basic_istream< char >& inputStream)
-        : inputStream_{inputStream}
+    LZMADecompressStream(const LZMADecompressStream&) = delete;
+    LZMADecompressStream& operator=(const LZMADecompressStream&) = delete;
+
+    /// Creates a decompressor reads compressed data from the given producer
+    /// @param[in] input is the producer of compressed data
+    /// @param[in] threads is number of decoder threads, 0 - number of CPUs
+    /// @param[in] memoryLimit is memory usage limit of threaded decoding,
+    ///     0 - quarter of physical memory; above the limit a block is decoded by one thread
+    /// @throw std::runtime_error on decoder initialization error
+    LZMADecompressStream(std::unique_ptr< ChunkProducer > input, unsigned threads = 1,
+            std::uint64_t memoryLimit = 0)
+        : input_{std::move(input)}
     {
-        lzma_stream xzStream_init = LZMA_STREAM_INIT;
-        xzStream_ = xzStream_init;
+#if LZMA_VERSION >= 50040002
+        if (threads == 0) {
+            threads = std::max< std::uint32_t >(lzma_cputhreads(), 1);
+        }
+        if (threads > 1) {
+            if (memoryLimit == 0) {
+                memoryLimit = std::max< std::uint64_t >(lzma_physmem() / 4, 1);
+            }
 
-        xzResult_ = lzma_stream_decoder(&xzStream_, MemoryLimit, DecoderFlags);
-        if (xzResult_ != LZMA_OK) {
-            throwEx< std::runtime_error >("LZMA decoder error");
+            lzma_mt mt{};
+            mt.flags = DecoderFlags;
+            mt.threads = threads;
+            mt.memlimit_threading = memoryLimit;
+            mt.memlimit_stop = MemoryLimit;
+            if (lzma_stream_decoder_mt(&xzStream_, &mt) != LZMA_OK) {
+                throwEx< std::runtime_error >("LZMA decoder error");
+            }
+            return;
         }
+#else // LZMA_VERSION >= 50040002
+        static_cast< void >(threads);
+        static_cast< void >(memoryLimit);
+#endif // LZMA_VERSION >= 50040002
 
-        setp(0, 0);
-        setg(outputBuffer_, outputBuffer_, outputBuffer_ + 0);
+        if (lzma_stream_decoder(&xzStream_, MemoryLimit, DecoderFlags) != LZMA_OK) {
+            throwEx< std::runtime_error >("LZMA decoder error");
+        }
     }
 
-    /// Cleans the lzma compressor
-    virtual ~LZMADecompressStreamBuffer() noexcept
+    /// Cleans the lzma decompressor
+    ~LZMADecompressStream() noexcept override
     {
         lzma_end(&xzStream_);
     }
 
-protected:
-    // If the input buffer is empty, decompress some more
-    int_type underflow() override
+    /// @copydoc ChunkProducer::produce()
+    std::size_t produce(void* buffer, std::size_t size) override
     {
-        // If everything has been decompressed already, it must be the end of the stream
         if (outputDone_) {
-            return traits_type::eof();
+            return 0;
         }
 
-        outputLength_ = 0;
-
-        // Run one iteration of decoding until there is something in the buffer
-        while (!outputDone_ && outputLength_ == 0) {
-            if (inputLength_ == 0 && !inputDone_) {
-                // Attempt to read from the input buffer
-                inputStream_.read(inputBuffer_, BufferSize);
-
-                // Retrieve the number of characters in the buffer
-                inputLength_ = inputStream_.gcount();
-
-                // Set xz input properties
-                xzStream_.next_in = reinterpret_cast< std::uint8_t* >(inputBuffer_);
-                xzStream_.avail_in = inputLength_;
+        xzStream_.next_out = static_cast< std::uint8_t* >(buffer);
+        xzStream_.avail_out = size;
 
-                // If done, finalise the stream (decompress the remaining data), otherwise run with more input
-                inputDone_ = inputStream_.eof();
+        while (xzStream_.avail_out) {
+            if (xzStream_.avail_in == 0 && !inputDone_) {
+                xzStream_.next_in = reinterpret_cast< std::uint8_t* >(inputBuffer_.data());
+                xzStream_.avail_in = input_->produce(inputBuffer_.data(), inputBuffer_.size());
+                inputDone_ = xzStream_.avail_in == 0;
             }
-            xzAction_ = inputDone_ ? LZMA_FINISH : LZMA_RUN;
 
-            // Set xz stream properties
-            xzStream_.next_out = reinterpret_cast< std::uint8_t* >(outputBuffer_);
-            xzStream_.avail_out = BufferSize;
-
-            // Applies the actual decompression
-            xzResult_ = lzma_code(&xzStream_, xzAction_);
-
-            if ((xzResult_ != LZMA_OK) && (xzResult_ != LZMA_STREAM_END)) {
+            // If done, finalise the stream (decompress the remaining data), otherwise run with more input
+            const lzma_ret result = lzma_code(&xzStream_, inputDone_ ? LZMA_FINISH : LZMA_RUN);
+            if (result == LZMA_STREAM_END) {
+                outputDone_ = true;
+                break;
+            }
+            if (result != LZMA_OK) {
                 throwEx< std::runtime_error >("LZMA decoder couldn't decompress data");
-            } else {
-                // Get how many bytes of the buffer were filled
-                outputLength_ = BufferSize - xzStream_.avail_out;
-
-                // Set the get pointer
-                setg(outputBuffer_, outputBuffer_ + 0, outputBuffer_ + outputLength_);
-
-                // Update input length, so we know when to fetch new data
-                inputLength_ = xzStream_.avail_in;
             }
-
-            outputDone_ = outputDone_ || (xzResult_ == LZMA_STREAM_END);
-        }
-
-        // Return the first character of the new buffer, or eof if the stream ends
-        if (outputLength_ > 0) {
-            return traits_type::to_int_type(outputBuffer_[0]);
         }
 
-        return traits_type::eof();
+        return size - xzStream_.avail_out;
     }
 };
 
-} /* namespace details */
-
-/// A stream that reads compressed data from the underlying stream, and provides the decompressed data
-class LZMADecompressStream final
-    : public std::basic_istream< char >
-{
-private:
-    // The streambuffer responsible for the actual decompression
-    details::LZMADecompressStreamBuffer streamBuffer_;
-
-public:
-    /// Creates a decompression reads compressed data from the given stream, and provides decompressed data
-    LZMADecompressStream(std::basic_istream< char >& streamBuffer)
-        : basic_istream< char >(&streamBuffer_)
-        , streamBuffer_(streamBuffer)
-    {}
-
-    virtual ~LZMADecompressStream() noexcept
-    {}
-};
-
 } /* namespace netbox::utils */
 
 #endif /* KSERGEY_LZMADecompressStream_160918003744 */
@@ -0,0 +1,136 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_MappedFile_171026101512
+#define KSERGEY_MappedFile_171026101512
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <netbox/buffer.h>
+#include <netbox/debug.h>
+
+namespace netbox::utils {
+
+/// Read-only memory mapped file
+class MappedFile
+{
+private:
+    void* data_{nullptr};
+    std::size_t size_{0};
+
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Move constructor
+    MappedFile(MappedFile&& other) noexcept
+    {
+        swap(other);
+    }
+
+    /// Move operator
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            swap(other);
+        }
+        return *this;
+    }
+
+    /// Construct unmapped file
+    MappedFile() = default;
+
+    /// Map file from disk
+    /// @param[in] filename is path to file
+    MappedFile(const char* filename)
+    {
+        int fd = ::open(filename, O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            debug("<WARN> File open error (%s): %s", filename, std::strerror(errno));
+            return;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+            debug("<WARN> File stat error (%s): %s", filename, std::strerror(errno));
+        } else if (st.st_size > 0) {
+            void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                debug("<WARN> File map error (%s): %s", filename, std::strerror(errno));
+            } else {
+                data_ = data;
+                size_ = st.st_size;
+            }
+        }
+
+        // Mapping stays valid after descriptor closed
+        ::close(fd);
+    }
+
+    /// Destructor
+    ~MappedFile() noexcept
+    {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    /// Return true if file mapped
+    explicit operator bool() const noexcept
+    {
+        return data_ != nullptr;
+    }
+
+    /// Return pointer to mapped data
+    const char* data() const noexcept
+    {
+        return static_cast< const char* >(data_);
+    }
+
+    /// Return size of mapped data
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Return mapped data as buffer
+    ConstBuffer buffer() const noexcept
+    {
+        return {data_, size_};
+    }
+
+    /// Give the kernel advice about use of the mapped range (see `man 2 madvise`)
+    /// @param[in] offset is range offset, rounded down to page boundary
+    /// @param[in] size is range size, clamped to the end of mapping
+    /// @param[in] advice is one of MADV_* values
+    bool advise(std::size_t offset, std::size_t size, int advice) noexcept
+    {
+        if (!data_ || offset >= size_) {
+            return false;
+        }
+
+        const std::size_t pageSize = ::getpagesize();
+        const std::size_t alignedOffset = offset - offset % pageSize;
+        size = std::min(size + (offset - alignedOffset), size_ - alignedOffset);
+        return 0 == ::madvise(static_cast< char* >(data_) + alignedOffset, size, advice);
+    }
+
+    /// Swap MappedFile internals with other instance
+    void swap(MappedFile& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_MappedFile_171026101512 */
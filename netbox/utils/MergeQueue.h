@@ -0,0 +1,141 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_MergeQueue_181026134012
+#define KSERGEY_MergeQueue_181026134012
+
+#include <cstdint>
+#include <vector>
+
+namespace netbox::utils {
+
+/// Priority queue of k-way merge
+/// Flat 4-ary min-heap of (key, source) pairs, equal keys are ordered by source.
+/// Allocation free once reserved for the number of sources.
+class MergeQueue
+{
+public:
+    /// Queue entry
+    struct Entry
+    {
+        /// Ordering key (i.e. timestamp)
+        std::uint64_t key;
+        /// Index of the source entry belongs to
+        std::uint32_t source;
+
+        /// Return true if entry goes before `other`
+        constexpr bool operator<(const Entry& other) const noexcept
+        {
+            return key < other.key || (key == other.key && source < other.source);
+        }
+    };
+
+private:
+    static constexpr std::size_t Arity = 4;
+
+    std::vector< Entry > heap_;
+
+public:
+    /// Reserve space for `size` sources
+    void reserve(std::size_t size)
+    {
+        heap_.reserve(size);
+    }
+
+    /// Return true if queue empty
+    bool empty() const noexcept
+    {
+        return heap_.empty();
+    }
+
+    /// Return number of entries
+    std::size_t size() const noexcept
+    {
+        return heap_.size();
+    }
+
+    /// Remove all entries
+    void clear() noexcept
+    {
+        heap_.clear();
+    }
+
+    /// Return the least entry
+    /// @pre `!empty()`
+    const Entry& top() const noexcept
+    {
+        return heap_.front();
+    }
+
+    /// Insert entry
+    void push(const Entry& entry)
+    {
+        heap_.push_back(entry);
+        siftUp(heap_.size() - 1);
+    }
+
+    /// Remove the least entry
+    /// @pre `!empty()`
+    void pop() noexcept
+    {
+        const Entry last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            siftDown(last);
+        }
+    }
+
+    /// Replace the least entry with `entry`
+    /// Cheaper than `pop()` followed by `push()`
+    /// @pre `!empty()`
+    void replaceTop(const Entry& entry) noexcept
+    {
+        siftDown(entry);
+    }
+
+private:
+    void siftUp(std::size_t index) noexcept
+    {
+        const Entry entry = heap_[index];
+        while (index > 0) {
+            const std::size_t parent = (index - 1) / Arity;
+            if (!(entry < heap_[parent])) {
+                break;
+            }
+            heap_[index] = heap_[parent];
+            index = parent;
+        }
+        heap_[index] = entry;
+    }
+
+    /// Place `entry` at root and move it down to its position
+    void siftDown(const Entry& entry) noexcept
+    {
+        const std::size_t size = heap_.size();
+        std::size_t index = 0;
+        while (true) {
+            const std::size_t first = index * Arity + 1;
+            if (first >= size) {
+                break;
+            }
+            const std::size_t last = first + Arity < size ? first + Arity : size;
+            std::size_t least = first;
+            for (std::size_t child = first + 1; child < last; ++child) {
+                if (heap_[child] < heap_[least]) {
+                    least = child;
+                }
+            }
+            if (!(heap_[least] < entry)) {
+                break;
+            }
+            heap_[index] = heap_[least];
+            index = least;
+        }
+        heap_[index] = entry;
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_MergeQueue_181026134012 */
@@ -0,0 +1,201 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_PipelinedChunkConsumer_181026172031
+#define KSERGEY_PipelinedChunkConsumer_181026172031
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkConsumer.h>
+
+namespace netbox::utils {
+
+/// Run consumer on a background thread
+/// Consumed data is collected into a ring of `depth` chunks drained by the thread,
+/// so consuming (i.e. compression) overlaps with producing the data.
+class PipelinedChunkConsumer final
+    : public ChunkConsumer
+{
+private:
+    struct Chunk
+    {
+        Arena data;
+        std::size_t size{0};
+    };
+
+    std::unique_ptr< ChunkConsumer > output_;
+    std::vector< Chunk > chunks_;
+
+    // Shared state, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::size_t head_{0};
+    std::size_t tail_{0};
+    bool finish_{false};
+    bool done_{false};
+    bool stop_{false};
+    std::exception_ptr error_;
+
+    // Producer state, chunk being filled
+    Chunk* current_{nullptr};
+
+    std::thread thread_;
+
+public:
+    PipelinedChunkConsumer(const PipelinedChunkConsumer&) = delete;
+    PipelinedChunkConsumer& operator=(const PipelinedChunkConsumer&) = delete;
+
+    /// Start background thread consuming into `output`
+    /// @param[in] output is the consumer to run in background
+    /// @param[in] depth is number of chunks queued
+    /// @param[in] chunkSize is size of each chunk
+    PipelinedChunkConsumer(std::unique_ptr< ChunkConsumer > output, std::size_t depth, std::size_t chunkSize)
+        : output_{std::move(output)}
+        , chunks_(std::max< std::size_t >(depth, 1))
+    {
+        for (auto& chunk: chunks_) {
+            chunk.data.reserve(chunkSize);
+        }
+        current_ = &chunks_[0];
+        thread_ = std::thread{[this] { run(); }};
+    }
+
+    /// Stop background thread, data not finished is dropped
+    ~PipelinedChunkConsumer() noexcept override
+    {
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            stop_ = true;
+        }
+        notEmpty_.notify_one();
+        thread_.join();
+    }
+
+    /// @copydoc ChunkConsumer::consume()
+    /// @throw Rethrow exception raised by output consumer (the first one, on every call after)
+    void consume(const iovec* chunks, std::size_t count) override
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* data = static_cast< const char* >(chunks[i].iov_base);
+            std::size_t size = chunks[i].iov_len;
+            while (size > 0) {
+                if (NETBOX_UNLIKELY(!current_)) {
+                    acquire();
+                }
+                const std::size_t length = std::min(size, current_->data.size() - current_->size);
+                std::memcpy(current_->data.data() + current_->size, data, length);
+                current_->size += length;
+                data += length;
+                size -= length;
+                if (current_->size == current_->data.size()) {
+                    submit(false);
+                }
+            }
+        }
+    }
+
+    /// @copydoc ChunkConsumer::finish()
+    /// Waits until all data consumed by output consumer
+    /// @throw Rethrow exception raised by output consumer
+    void finish() override
+    {
+        if (!current_) {
+            acquire();
+        }
+        submit(true);
+
+        std::unique_lock< std::mutex > lock{mutex_};
+        notFull_.wait(lock, [this] { return done_; });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    /// Queue filled chunk to background thread
+    void submit(bool last)
+    {
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            if (error_) {
+                std::rethrow_exception(error_);
+            }
+            tail_ += 1;
+            finish_ = last;
+        }
+        notEmpty_.notify_one();
+        current_ = nullptr;
+    }
+
+    /// Wait for free chunk
+    void acquire()
+    {
+        std::unique_lock< std::mutex > lock{mutex_};
+        notFull_.wait(lock, [this] { return tail_ - head_ < chunks_.size() || done_; });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        current_ = &chunks_[tail_ % chunks_.size()];
+        current_->size = 0;
+    }
+
+    void run() noexcept
+    {
+        while (true) {
+            std::size_t index;
+            bool last;
+            {
+                std::unique_lock< std::mutex > lock{mutex_};
+                notEmpty_.wait(lock, [this] { return stop_ || head_ != tail_; });
+                if (stop_) {
+                    return;
+                }
+                index = head_ % chunks_.size();
+                last = finish_ && head_ + 1 == tail_;
+            }
+
+            Chunk& chunk = chunks_[index];
+            bool failed = false;
+
+            try {
+                const iovec data{chunk.data.data(), chunk.size};
+                if (data.iov_len > 0) {
+                    output_->consume(&data, 1);
+                }
+                if (last) {
+                    output_->finish();
+                }
+            } catch (...) {
+                std::lock_guard< std::mutex > lock{mutex_};
+                error_ = std::current_exception();
+                failed = true;
+            }
+
+            {
+                std::lock_guard< std::mutex > lock{mutex_};
+                head_ += 1;
+                done_ = last || failed;
+            }
+            notFull_.notify_one();
+
+            if (last || failed) {
+                return;
+            }
+        }
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_PipelinedChunkConsumer_181026172031 */
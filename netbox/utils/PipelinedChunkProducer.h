@@ -0,0 +1,224 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_PipelinedChunkProducer_181026092615
+#define KSERGEY_PipelinedChunkProducer_181026092615
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <netbox/compiler.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
+
+namespace netbox::utils {
+
+/// Run producer on a background thread
+/// The thread fills a ring of `depth` chunks ahead of the consumer,
+/// so producing (i.e. decompression) overlaps with consuming.
+/// Chunks could be taken without copying by `exchange()`.
+class PipelinedChunkProducer final
+    : public ChunkProducer
+{
+private:
+    struct Chunk
+    {
+        Arena data;
+        std::size_t size{0};
+    };
+
+    std::unique_ptr< ChunkProducer > input_;
+    std::vector< Chunk > chunks_;
+    // Free space in front of chunk data, for the consumer's unread data
+    std::size_t headroom_;
+    std::size_t chunkSize_;
+
+    // Shared state, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::size_t head_{0};
+    std::size_t tail_{0};
+    bool done_{false};
+    bool stop_{false};
+    std::exception_ptr error_;
+
+    // Consumer state
+    const char* current_{nullptr};
+    const char* end_{nullptr};
+    bool holding_{false};
+
+    std::thread thread_;
+
+public:
+    PipelinedChunkProducer(const PipelinedChunkProducer&) = delete;
+    PipelinedChunkProducer& operator=(const PipelinedChunkProducer&) = delete;
+
+    /// Start background thread producing from `input`
+    /// @param[in] input is the producer to run in background
+    /// @param[in] depth is number of chunks produced ahead
+    /// @param[in] chunkSize is size of each chunk
+    /// @param[in] headroom is space reserved in front of each chunk (see `exchange()`)
+    PipelinedChunkProducer(std::unique_ptr< ChunkProducer > input, std::size_t depth, std::size_t chunkSize,
+            std::size_t headroom = 0)
+        : input_{std::move(input)}
+        , chunks_(std::max< std::size_t >(depth, 1))
+        , headroom_{headroom}
+        , chunkSize_{chunkSize}
+    {
+        for (auto& chunk: chunks_) {
+            chunk.data.reserve(headroom_ + chunkSize_);
+        }
+        thread_ = std::thread{[this] { run(); }};
+    }
+
+    /// Stop background thread
+    ~PipelinedChunkProducer() noexcept override
+    {
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            stop_ = true;
+        }
+        notFull_.notify_one();
+        thread_.join();
+    }
+
+    /// @copydoc ChunkProducer::produce()
+    /// @throw Rethrow exception raised by input producer
+    std::size_t produce(void* buffer, std::size_t size) override
+    {
+        if (NETBOX_UNLIKELY(current_ == end_) && !acquire()) {
+            return 0;
+        }
+
+        const std::size_t count = std::min(size, std::size_t(end_ - current_));
+        std::memcpy(buffer, current_, count);
+        current_ += count;
+        return count;
+    }
+
+    /// Return space reserved in front of chunks
+    std::size_t headroom() const noexcept
+    {
+        return headroom_;
+    }
+
+    /// Hand over the next chunk without copying, the chunk buffer is swapped
+    /// with `buffer`, which is filled by the background thread afterwards
+    /// @param[in,out] buffer is consumer buffer, replaced by the chunk buffer
+    /// @param[in] prefix is data to place just before the chunk data (may point into `buffer`)
+    /// @param[in] prefixSize is size of `prefix`, up to `headroom()`
+    /// @return Bytes of chunk data, starting at `headroom()` offset of `buffer`,
+    ///     0 if no more data available (`buffer` is left intact)
+    /// @pre Data returned by `produce()` is consumed
+    /// @throw Rethrow exception raised by input producer
+    std::size_t exchange(Arena& buffer, const char* prefix, std::size_t prefixSize)
+    {
+        if (!acquire()) {
+            return 0;
+        }
+
+        Chunk& chunk = chunks_[head_ % chunks_.size()];
+        std::memcpy(chunk.data.data() + headroom_ - prefixSize, prefix, prefixSize);
+        std::swap(chunk.data, buffer);
+        const std::size_t size = chunk.size;
+        current_ = end_ = nullptr;
+
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            head_ += 1;
+            holding_ = false;
+        }
+        notFull_.notify_one();
+        return size;
+    }
+
+private:
+    /// Release consumed chunk and wait for the next one
+    bool acquire()
+    {
+        std::unique_lock< std::mutex > lock{mutex_};
+
+        if (holding_) {
+            head_ += 1;
+            holding_ = false;
+            notFull_.notify_one();
+        }
+
+        notEmpty_.wait(lock, [this] { return head_ != tail_ || done_; });
+
+        if (head_ == tail_) {
+            if (error_) {
+                std::rethrow_exception(std::exchange(error_, nullptr));
+            }
+            return false;
+        }
+
+        Chunk& chunk = chunks_[head_ % chunks_.size()];
+        current_ = chunk.data.data() + headroom_;
+        end_ = current_ + chunk.size;
+        holding_ = true;
+        return true;
+    }
+
+    void run() noexcept
+    {
+        while (true) {
+            std::size_t index;
+            {
+                std::unique_lock< std::mutex > lock{mutex_};
+                notFull_.wait(lock, [this] { return stop_ || tail_ - head_ < chunks_.size(); });
+                if (stop_) {
+                    return;
+                }
+                index = tail_ % chunks_.size();
+            }
+
+            Chunk& chunk = chunks_[index];
+            chunk.size = 0;
+            bool done = false;
+
+            try {
+                // Buffer could be handed in by `exchange()`
+                char* data = chunk.data.reserve(headroom_ + chunkSize_) + headroom_;
+                const std::size_t capacity = chunk.data.size() - headroom_;
+                while (chunk.size < capacity) {
+                    const std::size_t count = input_->produce(data + chunk.size, capacity - chunk.size);
+                    if (count == 0) {
+                        done = true;
+                        break;
+                    }
+                    chunk.size += count;
+                }
+            } catch (...) {
+                std::lock_guard< std::mutex > lock{mutex_};
+                error_ = std::current_exception();
+                done = true;
+            }
+
+            {
+                std::lock_guard< std::mutex > lock{mutex_};
+                if (chunk.size > 0) {
+                    tail_ += 1;
+                }
+                done_ = done;
+            }
+            notEmpty_.notify_one();
+
+            if (done) {
+                return;
+            }
+        }
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_PipelinedChunkProducer_181026092615 */
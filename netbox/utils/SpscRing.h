@@ -0,0 +1,97 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_SpscRing_181026141520
+#define KSERGEY_SpscRing_181026141520
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include <netbox/compiler.h>
+
+namespace netbox::utils {
+
+/// Bounded lock-free single producer single consumer ring
+/// `tryPush()` should be called by one thread at a time, `tryPop()` by another one.
+template< class T >
+class SpscRing
+{
+    static_assert( std::is_trivially_copyable< T >(), "Non trivially copyable type" );
+
+private:
+    std::unique_ptr< T[] > data_;
+    std::size_t mask_{0};
+
+    // Consumer side
+    alignas(NETBOX_CACHE_LINE_SIZE) std::atomic< std::size_t > head_{0};
+    std::size_t tailCache_{0};
+
+    // Producer side
+    alignas(NETBOX_CACHE_LINE_SIZE) std::atomic< std::size_t > tail_{0};
+    std::size_t headCache_{0};
+
+public:
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /// Construct ring able to hold at least `capacity` elements
+    explicit SpscRing(std::size_t capacity)
+    {
+        std::size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        data_.reset(new T[size]);
+        mask_ = size - 1;
+    }
+
+    /// Return ring capacity
+    std::size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    /// Return true if ring empty (approximate when called by producer)
+    bool empty() const noexcept
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /// Push element (producer side)
+    /// @return False if ring full
+    bool tryPush(const T& value) noexcept
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (NETBOX_UNLIKELY(tail - headCache_ > mask_)) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ > mask_) {
+                return false;
+            }
+        }
+        data_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop element (consumer side)
+    /// @return False if ring empty
+    bool tryPop(T& value) noexcept
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (NETBOX_UNLIKELY(head == tailCache_)) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        value = data_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_SpscRing_181026141520 */
@@ -0,0 +1,93 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ZSTDCompressStream_181026171547
+#define KSERGEY_ZSTDCompressStream_181026171547
+
+#include <memory>
+#include <string>
+#include <zstd.h>
+
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkConsumer.h>
+
+namespace netbox::utils {
+
+/// Compress consumed data into ZSTD format (single frame)
+class ZSTDCompressStream final
+    : public ChunkConsumer
+{
+private:
+    // The consumer of compressed data
+    std::unique_ptr< ChunkConsumer > output_;
+
+    // Buffer for compressed data
+    Arena outputBuffer_{ZSTD_CStreamOutSize()};
+
+    // ZSTD stream
+    std::unique_ptr< ZSTD_CCtx, std::size_t (*)(ZSTD_CCtx*) > context_{ZSTD_createCCtx(), ZSTD_freeCCtx};
+
+public:
+    ZSTDCompressStream(const ZSTDCompressStream&) = delete;
+    ZSTDCompressStream& operator=(const ZSTDCompressStream&) = delete;
+
+    /// Creates a compressor writes compressed data into the given consumer
+    /// @param[in] output is consumer of compressed data
+    /// @param[in] level is compression level, 0 - library default
+    ZSTDCompressStream(std::unique_ptr< ChunkConsumer > output, int level = 0)
+        : output_{std::move(output)}
+    {
+        if (!context_) {
+            throwEx< std::runtime_error >("ZSTD encoder error");
+        }
+        check(ZSTD_CCtx_setParameter(context_.get(), ZSTD_c_compressionLevel, level));
+    }
+
+    /// @copydoc ChunkConsumer::consume()
+    void consume(const iovec* chunks, std::size_t count) override
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            ZSTD_inBuffer input{chunks[i].iov_base, chunks[i].iov_len, 0};
+            while (input.pos < input.size) {
+                compress(input, ZSTD_e_continue);
+            }
+        }
+    }
+
+    /// @copydoc ChunkConsumer::finish()
+    void finish() override
+    {
+        ZSTD_inBuffer input{nullptr, 0, 0};
+        while (compress(input, ZSTD_e_end) != 0)
+        {}
+        output_->finish();
+    }
+
+private:
+    /// Run compression step, write produced data
+    /// @return Value returned by `ZSTD_compressStream2()`
+    std::size_t compress(ZSTD_inBuffer& input, ZSTD_EndDirective mode)
+    {
+        ZSTD_outBuffer output{outputBuffer_.data(), outputBuffer_.size(), 0};
+        const std::size_t result = check(ZSTD_compressStream2(context_.get(), &output, &input, mode));
+        if (output.pos > 0) {
+            const iovec chunk{outputBuffer_.data(), output.pos};
+            output_->consume(&chunk, 1);
+        }
+        return result;
+    }
+
+    static std::size_t check(std::size_t result)
+    {
+        if (NETBOX_UNLIKELY(ZSTD_isError(result))) {
+            throwEx< std::runtime_error >(std::string{"ZSTD encoder error: "} + ZSTD_getErrorName(result));
+        }
+        return result;
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_ZSTDCompressStream_181026171547 */
@@ -0,0 +1,102 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ZSTDDecompressStream_181026122011
+#define KSERGEY_ZSTDDecompressStream_181026122011
+
+#include <memory>
+#include <zstd.h>
+
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
+
+namespace netbox::utils {
+
+/// Produce data decompressed from Zstandard encoded input
+/// Concatenated frames are decoded one after another, skippable frames
+/// (i.e. seek table of seekable format) are ignored.
+class ZSTDDecompressStream final
+    : public ChunkProducer
+{
+private:
+    static constexpr std::size_t BufferSize = 1024 * 1024;
+
+    struct Deleter
+    {
+        void operator()(ZSTD_DStream* stream) const noexcept
+        {
+            ZSTD_freeDStream(stream);
+        }
+    };
+
+    // The producer of compressed data
+    std::unique_ptr< ChunkProducer > input_;
+
+    // Buffer for compressed data
+    Arena inputBuffer_{BufferSize};
+    ZSTD_inBuffer in_{nullptr, 0, 0};
+
+    // Whether the current frame is complete
+    bool frameDone_{true};
+
+    // Whether all output has been produced
+    bool outputDone_{false};
+
+    // The actual decompressor
+    std::unique_ptr< ZSTD_DStream, Deleter > stream_;
+
+public:
+    ZSTDDecompressStream(const ZSTDDecompressStream&) = delete;
+    ZSTDDecompressStream& operator=(const ZSTDDecompressStream&) = delete;
+
+    /// Creates a decompressor reads compressed data from the given producer
+    /// @throw std::runtime_error on decoder initialization error
+    ZSTDDecompressStream(std::unique_ptr< ChunkProducer > input)
+        : input_{std::move(input)}
+        , stream_{ZSTD_createDStream()}
+    {
+        if (!stream_ || ZSTD_isError(ZSTD_initDStream(stream_.get()))) {
+            throwEx< std::runtime_error >("ZSTD decoder error");
+        }
+    }
+
+    /// @copydoc ChunkProducer::produce()
+    /// @throw std::runtime_error on corrupted or truncated input
+    std::size_t produce(void* buffer, std::size_t size) override
+    {
+        if (outputDone_) {
+            return 0;
+        }
+
+        ZSTD_outBuffer out{buffer, size, 0};
+
+        while (out.pos < out.size) {
+            if (in_.pos == in_.size) {
+                in_.src = inputBuffer_.data();
+                in_.size = input_->produce(inputBuffer_.data(), inputBuffer_.size());
+                in_.pos = 0;
+                if (in_.size == 0) {
+                    if (!frameDone_) {
+                        throwEx< std::runtime_error >("ZSTD truncated input");
+                    }
+                    outputDone_ = true;
+                    break;
+                }
+            }
+
+            const std::size_t result = ZSTD_decompressStream(stream_.get(), &out, &in_);
+            if (ZSTD_isError(result)) {
+                throwEx< std::runtime_error >("ZSTD decoder couldn't decompress data");
+            }
+            frameDone_ = result == 0;
+        }
+
+        return out.pos;
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_ZSTDDecompressStream_181026122011 */
@@ -0,0 +1,288 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#ifndef KSERGEY_ZSTDSeekableDecompressStream_181026123107
+#define KSERGEY_ZSTDSeekableDecompressStream_181026123107
+
+#include <endian.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <zstd.h>
+
+#include <netbox/compiler.h>
+#include <netbox/exception.h>
+#include <netbox/utils/Arena.h>
+#include <netbox/utils/ChunkProducer.h>
+#include <netbox/utils/FileChunkProducer.h>
+
+namespace netbox::utils {
+
+/// Produce data decompressed from Zstandard seekable format file
+/// Frames listed in the seek table are decoded in parallel by worker threads
+/// and produced in file order. At most `2 * threads` frames are held in memory.
+class ZSTDSeekableDecompressStream final
+    : public ChunkProducer
+{
+public:
+    /// Frame of seekable file
+    struct Frame
+    {
+        /// Offset of compressed frame inside file
+        std::uint64_t offset;
+        /// Size of compressed frame
+        std::uint32_t compressedSize;
+        /// Size of decompressed frame
+        std::uint32_t decompressedSize;
+    };
+
+private:
+    static constexpr std::uint32_t SeekableMagic = 0x8f92eab1;
+    static constexpr std::uint32_t SkippableMagic = 0x184d2a5e;
+    static constexpr std::size_t FooterSize = 9;
+    static constexpr std::size_t SkippableHeaderSize = 8;
+
+    struct Slot
+    {
+        Arena data;
+        std::size_t size{0};
+        bool ready{false};
+    };
+
+    struct Deleter
+    {
+        void operator()(ZSTD_DCtx* context) const noexcept
+        {
+            ZSTD_freeDCtx(context);
+        }
+    };
+
+    std::unique_ptr< FileChunkProducer > file_;
+    std::vector< Frame > frames_;
+    std::vector< Slot > slots_;
+
+    // Shared state, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable notReady_;
+    std::condition_variable notFull_;
+    // Index of the next frame to decode
+    std::size_t next_{0};
+    // Index of the frame consumed (or being consumed)
+    std::size_t head_{0};
+    bool stop_{false};
+    std::exception_ptr error_;
+
+    // Consumer state
+    const char* current_{nullptr};
+    const char* end_{nullptr};
+    bool holding_{false};
+
+    std::vector< std::thread > threads_;
+
+public:
+    ZSTDSeekableDecompressStream(const ZSTDSeekableDecompressStream&) = delete;
+    ZSTDSeekableDecompressStream& operator=(const ZSTDSeekableDecompressStream&) = delete;
+
+    /// Read seek table of file
+    /// @param[in] file is file to read seek table from
+    /// @return Frames of file, empty if file is not in seekable format
+    static std::vector< Frame > readSeekTable(FileChunkProducer& file)
+    {
+        struct stat st;
+        if (::fstat(file.native(), &st) != 0 || std::uint64_t(st.st_size) < FooterSize) {
+            return {};
+        }
+        const std::uint64_t fileSize = st.st_size;
+
+        std::uint8_t footer[FooterSize];
+        if (file.readAt(footer, FooterSize, fileSize - FooterSize) != FooterSize
+                || readLE32(footer + 5) != SeekableMagic) {
+            return {};
+        }
+
+        const std::uint32_t count = readLE32(footer);
+        const std::uint8_t descriptor = footer[4];
+        if (descriptor & 0x7c) {
+            // Reserved bits set
+            return {};
+        }
+        const std::size_t entrySize = (descriptor & 0x80) ? 12 : 8;
+        const std::uint64_t tableSize = std::uint64_t(count) * entrySize;
+        if (fileSize < SkippableHeaderSize + tableSize + FooterSize) {
+            return {};
+        }
+
+        // Seek table is a skippable frame at the end of file
+        const std::uint64_t tableOffset = fileSize - FooterSize - tableSize - SkippableHeaderSize;
+        std::vector< std::uint8_t > table(SkippableHeaderSize + tableSize);
+        if (file.readAt(table.data(), table.size(), tableOffset) != table.size()
+                || readLE32(table.data()) != SkippableMagic
+                || readLE32(table.data() + 4) != tableSize + FooterSize) {
+            return {};
+        }
+
+        std::vector< Frame > frames(count);
+        std::uint64_t offset = 0;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const std::uint8_t* entry = table.data() + SkippableHeaderSize + i * entrySize;
+            frames[i].offset = offset;
+            frames[i].compressedSize = readLE32(entry);
+            frames[i].decompressedSize = readLE32(entry + 4);
+            offset += frames[i].compressedSize;
+        }
+        if (offset != tableOffset) {
+            return {};
+        }
+
+        return frames;
+    }
+
+    /// Start decoding of seekable file
+    /// @param[in] file is seekable format file
+    /// @param[in] frames is seek table of file
+    /// @param[in] threads is number of decoder threads, 0 - number of CPUs
+    ZSTDSeekableDecompressStream(std::unique_ptr< FileChunkProducer > file,
+            std::vector< Frame > frames, unsigned threads)
+        : file_{std::move(file)}
+        , frames_{std::move(frames)}
+    {
+        if (threads == 0) {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        slots_.resize(2 * threads);
+        threads_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] { run(); });
+        }
+    }
+
+    /// Stop worker threads
+    ~ZSTDSeekableDecompressStream() noexcept override
+    {
+        {
+            std::lock_guard< std::mutex > lock{mutex_};
+            stop_ = true;
+        }
+        notFull_.notify_all();
+        for (auto& thread: threads_) {
+            thread.join();
+        }
+    }
+
+    /// @copydoc ChunkProducer::produce()
+    /// @throw std::runtime_error on corrupted or truncated input
+    std::size_t produce(void* buffer, std::size_t size) override
+    {
+        while (NETBOX_UNLIKELY(current_ == end_)) {
+            if (!acquire()) {
+                return 0;
+            }
+        }
+
+        const std::size_t count = std::min(size, std::size_t(end_ - current_));
+        std::memcpy(buffer, current_, count);
+        current_ += count;
+        return count;
+    }
+
+private:
+    static std::uint32_t readLE32(const std::uint8_t* data) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return le32toh(value);
+    }
+
+    /// Release consumed frame and wait for the next one
+    bool acquire()
+    {
+        std::unique_lock< std::mutex > lock{mutex_};
+
+        if (holding_) {
+            slots_[head_ % slots_.size()].ready = false;
+            head_ += 1;
+            holding_ = false;
+            notFull_.notify_all();
+        }
+
+        if (head_ == frames_.size()) {
+            return false;
+        }
+
+        Slot& slot = slots_[head_ % slots_.size()];
+        notReady_.wait(lock, [this, &slot] { return slot.ready || error_; });
+
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+
+        current_ = slot.data.data();
+        end_ = current_ + slot.size;
+        holding_ = true;
+        return true;
+    }
+
+    void run() noexcept
+    {
+        std::unique_ptr< ZSTD_DCtx, Deleter > context{ZSTD_createDCtx()};
+        Arena input;
+
+        while (true) {
+            std::size_t index;
+            {
+                std::unique_lock< std::mutex > lock{mutex_};
+                notFull_.wait(lock, [this] {
+                    return stop_ || error_ || next_ == frames_.size() || next_ - head_ < slots_.size();
+                });
+                if (stop_ || error_ || next_ == frames_.size()) {
+                    return;
+                }
+                index = next_++;
+            }
+
+            const Frame& frame = frames_[index];
+            Slot& slot = slots_[index % slots_.size()];
+
+            try {
+                if (!context) {
+                    throwEx< std::runtime_error >("ZSTD decoder error");
+                }
+                input.reserve(frame.compressedSize);
+                if (file_->readAt(input.data(), frame.compressedSize, frame.offset) != frame.compressedSize) {
+                    throwEx< std::runtime_error >("ZSTD truncated input");
+                }
+                slot.data.reserve(std::max< std::size_t >(frame.decompressedSize, 1));
+                const std::size_t result = ZSTD_decompressDCtx(context.get(), slot.data.data(),
+                        frame.decompressedSize, input.data(), frame.compressedSize);
+                if (ZSTD_isError(result) || result != frame.decompressedSize) {
+                    throwEx< std::runtime_error >("ZSTD decoder couldn't decompress data");
+                }
+                slot.size = result;
+            } catch (...) {
+                std::lock_guard< std::mutex > lock{mutex_};
+                error_ = std::current_exception();
+                notReady_.notify_all();
+                notFull_.notify_all();
+                return;
+            }
+
+            {
+                std::lock_guard< std::mutex > lock{mutex_};
+                slot.ready = true;
+            }
+            notReady_.notify_all();
+        }
+    }
+};
+
+} /* namespace netbox::utils */
+
+#endif /* KSERGEY_ZSTDSeekableDecompressStream_181026123107 */
@@ -0,0 +1,211 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <sys/socket.h>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <netbox/Coroutine.h>
+#include <netbox/socket_ops.h>
+
+using namespace netbox;
+
+namespace {
+
+/// Create UDP socket bound to loopback ephemeral port
+Socket bindLoopback(IPv4::Endpoint& endpoint)
+{
+    auto socket = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    if (!bind(socket, IPv4::Endpoint{IPv4::Address::loopback(), 0})) {
+        throw std::runtime_error("bind");
+    }
+    socklen_t size = endpoint.size();
+    ::getsockname(socket.native(), endpoint.data(), &size);
+    return socket;
+}
+
+coro::Task echoServer(Reactor& reactor, Socket& listener)
+{
+    auto accepted = co_await coro::accept(reactor, listener);
+    if (!accepted) {
+        co_return;
+    }
+    Socket session = accepted.getSocket();
+    session.setNonBlocking();
+    char buffer[64];
+    while (true) {
+        auto received = co_await coro::recv(reactor, session, buffer, sizeof(buffer));
+        if (!received || received.bytes() == 0) {
+            break;
+        }
+        co_await coro::send(reactor, session, buffer, received.bytes());
+    }
+    // Client closed connection
+    reactor.stop();
+}
+
+coro::Task echoClient(Reactor& reactor, const IPv4::Endpoint& endpoint, std::string& reply)
+{
+    auto socket = Socket::create(AF_INET, SOCK_STREAM, 0);
+    socket.setNonBlocking();
+    if (!co_await coro::connect(reactor, socket, endpoint)) {
+        reactor.stop();
+        co_return;
+    }
+    for (const char* message: {"hello", "world"}) {
+        co_await coro::send(reactor, socket, message, std::strlen(message));
+        char buffer[64];
+        auto received = co_await coro::recv(reactor, socket, buffer, sizeof(buffer));
+        if (received) {
+            reply.append(buffer, received.bytes());
+        }
+    }
+}
+
+} /* namespace */
+
+TEST(Coroutine, FrameAllocator)
+{
+    auto& allocator = coro::FrameAllocator::instance();
+    void* frame = allocator.allocate(100);
+    allocator.deallocate(frame, 100);
+    ASSERT_EQ( allocator.allocate(128), frame );
+    allocator.deallocate(frame, 128);
+}
+
+TEST(Coroutine, Echo)
+{
+    Reactor reactor;
+
+    auto listener = Socket::create(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE( bind(listener, IPv4::Endpoint{IPv4::Address::loopback(), 0}) );
+    ASSERT_TRUE( listen(listener) );
+    ASSERT_TRUE( listener.setNonBlocking() );
+    IPv4::Endpoint endpoint;
+    socklen_t size = endpoint.size();
+    ::getsockname(listener.native(), endpoint.data(), &size);
+
+    std::string reply;
+    echoServer(reactor, listener);
+    echoClient(reactor, endpoint, reply);
+    reactor.run();
+    ASSERT_EQ( reply, "helloworld" );
+}
+
+TEST(Coroutine, RecvBatch)
+{
+    Reactor reactor;
+
+    IPv4::Endpoint receiverEndpoint;
+    auto receiver = bindLoopback(receiverEndpoint);
+    MessageBatch batch{8};
+    std::size_t received = 0;
+    [](Reactor& reactor, Socket& socket, MessageBatch& batch, std::size_t& received) -> coro::Task {
+        while (received < 3) {
+            auto result = co_await coro::recvBatch(reactor, socket, batch);
+            received += result ? result.bytes() : 0;
+        }
+        reactor.stop();
+    }(reactor, receiver, batch, received);
+
+    auto sender = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    for (int i = 0; i < 3; ++i) {
+        sendto(sender, "x", 1, receiverEndpoint.data(), receiverEndpoint.size());
+    }
+    reactor.run();
+    ASSERT_EQ( received, 3u );
+}
+
+TEST(Coroutine, ReaderAndWriter)
+{
+    Reactor reactor;
+
+    int fds[2];
+    ASSERT_EQ( ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0 );
+    Socket local{fds[0]};
+    Socket peer{fds[1]};
+
+    // Fill local send buffer, so the writer waits too
+    char buffer[4096] = {};
+    while (::send(local.native(), buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+    }
+
+    std::size_t done = 0;
+    std::string reply;
+    TransmitResult busy;
+    TransmitResult written;
+
+    [](Reactor& reactor, Socket& socket, std::string& reply, std::size_t& done) -> coro::Task {
+        char buffer[64];
+        auto received = co_await coro::recv(reactor, socket, buffer, sizeof(buffer));
+        if (received) {
+            reply.assign(buffer, received.bytes());
+        }
+        if (++done == 2) {
+            reactor.stop();
+        }
+    }(reactor, local, reply, done);
+
+    // Second reader of the same socket
+    [](Reactor& reactor, Socket& socket, TransmitResult& result) -> coro::Task {
+        char buffer[64];
+        result = co_await coro::recv(reactor, socket, buffer, sizeof(buffer));
+    }(reactor, local, busy);
+
+    [](Reactor& reactor, Socket& socket, TransmitResult& result, std::size_t& done) -> coro::Task {
+        result = co_await coro::send(reactor, socket, "x", 1);
+        if (++done == 2) {
+            reactor.stop();
+        }
+    }(reactor, local, written, done);
+
+    ASSERT_FALSE( busy );
+    ASSERT_EQ( busy.native(), EBUSY );
+    ASSERT_EQ( done, 0u );
+
+    // Peer drains the socket and replies
+    auto drain = [&] {
+        while (::recv(peer.native(), buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+        }
+        ::send(peer.native(), "pong", 4, MSG_DONTWAIT);
+    };
+    reactor.addTimer(std::chrono::milliseconds{1}, drain);
+    reactor.run();
+
+    ASSERT_EQ( reply, "pong" );
+    ASSERT_TRUE( written );
+    ASSERT_EQ( written.bytes(), 1u );
+}
+
+TEST(Coroutine, DescriptorReuse)
+{
+    Reactor reactor;
+
+    std::size_t received = 0;
+    auto receive = [](Reactor& reactor, Socket& socket, std::size_t& received) -> coro::Task {
+        char buffer[16];
+        for (int i = 0; i < 2; ++i) {
+            auto result = co_await coro::recv(reactor, socket, buffer, sizeof(buffer));
+            received += result ? result.bytes() : 0;
+        }
+        reactor.stop();
+    };
+
+    // Socket is closed while registered, the next one takes its descriptor
+    for (int i = 0; i < 3; ++i) {
+        IPv4::Endpoint endpoint;
+        auto socket = bindLoopback(endpoint);
+        receive(reactor, socket, received);
+        auto sender = Socket::create(AF_INET, SOCK_DGRAM, 0);
+        auto send = [&] {
+            sendto(sender, "x", 1, endpoint.data(), endpoint.size());
+        };
+        reactor.addTimer(std::chrono::milliseconds{1}, send);
+        reactor.addTimer(std::chrono::milliseconds{5}, send);
+        reactor.run();
+        ASSERT_EQ( received, 2u * (i + 1) );
+    }
+    ASSERT_EQ( received, 6u );
+}
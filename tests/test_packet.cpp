@@ -0,0 +1,386 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <netbox/CaptureGroup.h>
+#include <netbox/PacketRing.h>
+#include <netbox/PacketTxRing.h>
+#include <netbox/XdpSocket.h>
+#include <netbox/socket_ops.h>
+
+using namespace netbox;
+
+namespace {
+
+/// Offset of UDP payload inside Ethernet frame
+constexpr std::size_t UDPPayloadOffset = 14 + 20 + 8;
+
+constexpr std::uint16_t TestPort = 45871;
+
+/// Send `count` UDP datagrams "netbox-<i>" to loopback
+void sendDatagrams(std::size_t count)
+{
+    auto socket = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    const IPv4::Endpoint endpoint{IPv4::Address::loopback(), TestPort};
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string payload = "netbox-" + std::to_string(i);
+        sendto(socket, payload.data(), payload.size(), endpoint.data(), endpoint.size());
+    }
+}
+
+/// Return payload of test datagram or empty string
+std::string testPayload(const pcap::Packet& packet)
+{
+    if (packet.captureLength() <= UDPPayloadOffset) {
+        return {};
+    }
+    std::string payload{static_cast< const char* >(packet.data()) + UDPPayloadOffset,
+        packet.captureLength() - UDPPayloadOffset};
+    return payload.compare(0, 7, "netbox-") == 0 ? payload : std::string{};
+}
+
+/// Temporary veth pair "nbxdp0" <-> "nbxdp1"
+/// The pair lives in a private network namespace entered by the calling
+/// thread, so host network configuration is left untouched
+struct VethPair
+{
+    int hostNamespace{::open("/proc/thread-self/ns/net", O_RDONLY | O_CLOEXEC)};
+    bool isolated{hostNamespace != -1 && ::unshare(CLONE_NEWNET) == 0};
+    bool created{isolated
+        && std::system("ip link add nbxdp0 type veth peer name nbxdp1 2>/dev/null") == 0
+        && std::system("ip link set nbxdp0 up && ip link set nbxdp1 up") == 0};
+
+    ~VethPair()
+    {
+        // The pair is destroyed along with the namespace
+        if (isolated) {
+            ::setns(hostNamespace, CLONE_NEWNET);
+        }
+        if (hostNamespace != -1) {
+            ::close(hostNamespace);
+        }
+    }
+};
+
+/// Return true if frame is of `protocol` ethertype
+bool isProtocol(const pcap::Packet& packet, std::uint16_t protocol)
+{
+    const auto* frame = static_cast< const unsigned char* >(packet.data());
+    return packet.captureLength() >= 14 && frame[12] == (protocol >> 8) && frame[13] == (protocol & 0xff);
+}
+
+/// Write test frame with `sequence` of `Protocol` ethertype
+void makeFrame(char* frame, std::uint16_t protocol, std::uint32_t sequence)
+{
+    std::memset(frame, 0xff, 6);
+    std::memset(frame + 6, 0x02, 6);
+    frame[12] = char(protocol >> 8);
+    frame[13] = char(protocol & 0xff);
+    std::memcpy(frame + 14, &sequence, sizeof(sequence));
+}
+
+} /* namespace */
+
+TEST(Packet, RingGeometry)
+{
+    const std::size_t pageSize = ::sysconf(_SC_PAGESIZE);
+
+    auto geometry = details::RingGeometry::make(1000000, 100000, 2000);
+    ASSERT_EQ( geometry.frameSize % TPACKET_ALIGNMENT, 0u );
+    ASSERT_GE( geometry.frameSize, 2000u );
+    ASSERT_EQ( geometry.blockSize % pageSize, 0u );
+    ASSERT_EQ( (geometry.blockSize / pageSize) & (geometry.blockSize / pageSize - 1), 0u );
+    ASSERT_GE( geometry.blockSize, 100000u );
+    ASSERT_GE( geometry.size(), 1000000u );
+    ASSERT_EQ( geometry.frameCount, geometry.blockCount * (geometry.blockSize / geometry.frameSize) );
+
+    // Block holds at least one frame
+    geometry = details::RingGeometry::make(0, 0, 3 * pageSize);
+    ASSERT_GE( geometry.blockSize, 3 * pageSize );
+    ASSERT_EQ( geometry.blockCount, 1u );
+    ASSERT_EQ( geometry.frameCount, 1u );
+}
+
+TEST(Packet, RingCapture)
+{
+    PacketRingOptions options;
+    options.interface = "lo";
+    options.protocol = ETH_P_IP;
+    options.ringSize = 1024 * 1024;
+    options.blockSize = 64 * 1024;
+
+    std::unique_ptr< PacketRing > ring;
+    try {
+        ring = std::make_unique< PacketRing >(options);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    } catch (const SocketOptionError& e) {
+        GTEST_SKIP() << e.what();
+    }
+
+    // Ring memory is reused several times
+    constexpr std::size_t Rounds = 20;
+    constexpr std::size_t Count = 500;
+    for (std::size_t round = 0; round < Rounds; ++round) {
+        sendDatagrams(Count);
+
+        std::set< std::string > received;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (received.size() < Count && std::chrono::steady_clock::now() < deadline) {
+            if (!ring->wait(100)) {
+                continue;
+            }
+            for (auto& packet: ring->readBatch(64)) {
+                ASSERT_GT( packet.timestamp().tv_sec, 0 );
+                ASSERT_EQ( packet.captureLength(), packet.length() );
+                if (auto payload = testPayload(packet); !payload.empty()) {
+                    received.insert(payload);
+                }
+            }
+        }
+        ASSERT_EQ( received.size(), Count );
+
+        // Drain the rest
+        while (ring->wait(10)) {
+            ring->readBatch(64);
+        }
+    }
+}
+
+TEST(Packet, CaptureGroup)
+{
+    CaptureGroupOptions options;
+    options.ring.interface = "lo";
+    options.ring.protocol = ETH_P_IP;
+    options.ring.ringSize = 1024 * 1024;
+    options.ring.blockSize = 64 * 1024;
+    options.ring.blockTimeout = 1;
+    options.members = 3;
+    options.mode = FanoutMode::RoundRobin;
+    options.cpus = {0};
+    options.pollTimeout = 10;
+
+    std::unique_ptr< CaptureGroup > group;
+    try {
+        group = std::make_unique< CaptureGroup >(options);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    } catch (const SocketOptionError& e) {
+        GTEST_SKIP() << e.what();
+    }
+    ASSERT_EQ( group->size(), 3u );
+
+    std::atomic< std::size_t > counts[3] = {};
+    group->start([&counts](std::size_t member, pcap::PacketBatch batch) {
+        for (auto& packet: batch) {
+            if (!testPayload(packet).empty()) {
+                counts[member].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Outgoing packets are not seen by ETH_P_IP socket, no duplicates
+    constexpr std::size_t Count = 300;
+    sendDatagrams(Count);
+
+    auto total = [&counts] {
+        return counts[0].load() + counts[1].load() + counts[2].load();
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (total() < Count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    group->stop();
+
+    ASSERT_EQ( total(), Count );
+    for (auto& count: counts) {
+        ASSERT_GT( count.load(), 0u );
+    }
+
+    auto statistics = group->statistics();
+    ASSERT_GE( statistics.packets, Count );
+    ASSERT_EQ( statistics.drops, 0u );
+}
+
+TEST(Packet, TxRing)
+{
+    // Local experimental ethertype
+    constexpr std::uint16_t Protocol = 0x88b5;
+
+    PacketRingOptions rxOptions;
+    rxOptions.interface = "lo";
+    rxOptions.protocol = Protocol;
+    rxOptions.ringSize = 1024 * 1024;
+    rxOptions.blockSize = 64 * 1024;
+    rxOptions.blockTimeout = 1;
+
+    PacketTxRingOptions txOptions;
+    txOptions.interface = "lo";
+    txOptions.ringSize = 256 * 1024;
+    txOptions.blockSize = 16 * 1024;
+
+    std::unique_ptr< PacketRing > rx;
+    std::unique_ptr< PacketTxRing > tx;
+    try {
+        rx = std::make_unique< PacketRing >(rxOptions);
+        tx = std::make_unique< PacketTxRing >(txOptions);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    } catch (const SocketOptionError& e) {
+        GTEST_SKIP() << e.what();
+    }
+    ASSERT_EQ( tx->maxPacketSize(), 2048u - 32u );
+    ASSERT_FALSE( tx->write(std::string(tx->maxPacketSize() + 1, 'x').data(), tx->maxPacketSize() + 1) );
+
+    // More packets than the ring holds, sent in batches
+    constexpr std::size_t Count = 1000;
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (received < Count && std::chrono::steady_clock::now() < deadline) {
+        while (sent < Count) {
+            char* frame = static_cast< char* >(tx->acquire());
+            if (!frame) {
+                break;
+            }
+            std::memset(frame, 0, 12);
+            frame[12] = char(Protocol >> 8);
+            frame[13] = char(Protocol & 0xff);
+            const std::uint32_t sequence = sent;
+            std::memcpy(frame + 14, &sequence, sizeof(sequence));
+            tx->commit(64);
+            sent += 1;
+        }
+        if (tx->queued() > 0) {
+            ASSERT_TRUE( tx->flush(true) );
+        }
+
+        if (rx->wait(10)) {
+            for (auto& packet: rx->readBatch(64)) {
+                ASSERT_EQ( packet.captureLength(), 64u );
+                std::uint32_t sequence;
+                std::memcpy(&sequence, static_cast< const char* >(packet.data()) + 14, sizeof(sequence));
+                ASSERT_EQ( sequence, received );
+                received += 1;
+            }
+        }
+    }
+
+    ASSERT_EQ( sent, Count );
+    ASSERT_EQ( received, Count );
+    ASSERT_GT( Count, tx->geometry().frameCount );
+}
+
+TEST(Packet, XdpSocket)
+{
+    constexpr std::uint16_t Protocol = 0x88b5;
+
+    VethPair veth;
+    if (!veth.created) {
+        GTEST_SKIP() << "veth pair not available";
+    }
+
+    XdpSocketOptions xdpOptions;
+    xdpOptions.interface = "nbxdp0";
+    xdpOptions.ringSize = 256;
+
+    PacketRingOptions rxOptions;
+    rxOptions.interface = "nbxdp1";
+    rxOptions.protocol = Protocol;
+    rxOptions.ringSize = 1024 * 1024;
+    rxOptions.blockSize = 64 * 1024;
+    rxOptions.blockTimeout = 1;
+
+    PacketTxRingOptions txOptions;
+    txOptions.interface = "nbxdp1";
+    txOptions.ringSize = 256 * 1024;
+    txOptions.blockSize = 16 * 1024;
+
+    std::unique_ptr< XdpSocket > xdp;
+    std::unique_ptr< PacketRing > rx;
+    std::unique_ptr< PacketTxRing > tx;
+    try {
+        xdp = std::make_unique< XdpSocket >(xdpOptions);
+        rx = std::make_unique< PacketRing >(rxOptions);
+        tx = std::make_unique< PacketTxRing >(txOptions);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    } catch (const SocketOptionError& e) {
+        GTEST_SKIP() << e.what();
+    }
+
+    // Receive more packets than UMEM holds, frames are recycled
+    constexpr std::size_t Count = 1000;
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (received < Count && std::chrono::steady_clock::now() < deadline) {
+        while (sent < Count && sent < received + 128) {
+            char frame[64];
+            makeFrame(frame, Protocol, sent);
+            if (!tx->write(frame, sizeof(frame))) {
+                break;
+            }
+            sent += 1;
+        }
+        tx->flush(true);
+
+        xdp->wait(10);
+        for (auto& packet: xdp->receiveBatch(64)) {
+            // Interface also receives IPv6 neighbour discovery
+            if (!isProtocol(packet, Protocol)) {
+                continue;
+            }
+            ASSERT_EQ( packet.captureLength(), 64u );
+            std::uint32_t sequence;
+            std::memcpy(&sequence, static_cast< const char* >(packet.data()) + 14, sizeof(sequence));
+            ASSERT_EQ( sequence, received );
+            received += 1;
+        }
+    }
+    ASSERT_EQ( received, Count );
+
+    // Send more packets than TX frames, frames are reclaimed
+    sent = 0;
+    received = 0;
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (received < Count && std::chrono::steady_clock::now() < deadline) {
+        while (sent < Count && sent < received + 128) {
+            char frame[64];
+            makeFrame(frame, Protocol, sent);
+            if (!xdp->write(frame, sizeof(frame))) {
+                break;
+            }
+            sent += 1;
+        }
+        if (auto result = xdp->flush(); !result) {
+            ASSERT_TRUE( result.isTryAgain() || result.native() == EBUSY ) << result.str();
+        }
+
+        if (rx->wait(10)) {
+            for (auto& packet: rx->readBatch(64)) {
+                std::uint32_t sequence;
+                std::memcpy(&sequence, static_cast< const char* >(packet.data()) + 14, sizeof(sequence));
+                ASSERT_EQ( sequence, received );
+                received += 1;
+            }
+        }
+    }
+    ASSERT_EQ( received, Count );
+
+    auto statistics = xdp->statistics();
+    ASSERT_EQ( statistics.rxInvalid, 0u );
+    ASSERT_EQ( statistics.txInvalid, 0u );
+}
@@ -0,0 +1,1105 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined( netbox_PCAP_GZIP )
+#   include <zlib.h>
+#endif // defined( netbox_PCAP_GZIP )
+
+#if defined( netbox_PCAP_LZMA )
+#   include <lzma.h>
+#endif // defined( netbox_PCAP_LZMA )
+
+#if defined( netbox_PCAP_ZSTD )
+#   include <zstd.h>
+#endif // defined( netbox_PCAP_ZSTD )
+
+#if defined( netbox_PCAP_LZ4 )
+#   include <lz4frame.h>
+#endif // defined( netbox_PCAP_LZ4 )
+
+#include <gtest/gtest.h>
+#include <netbox/PcapPacketSource.h>
+#include <netbox/pcap/MappedReader.h>
+#include <netbox/pcap/Reader.h>
+#include <netbox/pcap/Writer.h>
+#include <netbox/pcapng/pcapng.h>
+
+using namespace netbox;
+
+namespace {
+
+/// Build PCAP file content with `count` packets
+/// Packet `i` has timestamp `i` seconds and `i + 1` bytes filled with `i`
+std::string makePcap(std::size_t count, std::uint32_t magic = pcap::NSecTCPDumpMagic)
+{
+    std::string content;
+
+    pcap::FileHeader fileHeader{};
+    fileHeader.magic = magic;
+    fileHeader.version_major = 2;
+    fileHeader.version_minor = 4;
+    fileHeader.snaplen = pcap::MaxSnapLen;
+    fileHeader.linktype = pcap::Ethernet;
+    content.append(reinterpret_cast< const char* >(&fileHeader), sizeof(fileHeader));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        pcap::PacketHeader header{};
+        header.ts_sec = i;
+        header.ts_usec = i;
+        header.caplen = i + 1;
+        header.len = i + 1;
+        content.append(reinterpret_cast< const char* >(&header), sizeof(header));
+        content.append(header.caplen, char(i));
+    }
+
+    return content;
+}
+
+/// Build PCAP file content with packets at `seconds` timestamps
+/// Each packet is single byte `tag`
+std::string makePcap(const std::vector< std::uint32_t >& seconds, char tag)
+{
+    std::string content = makePcap(0);
+    for (auto second: seconds) {
+        pcap::PacketHeader header{};
+        header.ts_sec = second;
+        header.caplen = 1;
+        header.len = 1;
+        content.append(reinterpret_cast< const char* >(&header), sizeof(header));
+        content.push_back(tag);
+    }
+    return content;
+}
+
+/// Build PCAPNG file content with the same packets as `makePcap(count)`
+/// The second half of packets is written in a byte-swapped section. Even packets
+/// belong to interface of nanosecond resolution, odd ones to interface of 2^-30
+/// resolution and one second offset. Each packet is followed by a packet of
+/// unsupported interface and an unknown block.
+std::string makePcapng(std::size_t count)
+{
+    std::string content;
+    bool swapped = false;
+
+    auto put = [&](auto value) {
+        if (swapped) {
+            std::reverse(reinterpret_cast< char* >(&value), reinterpret_cast< char* >(&value) + sizeof(value));
+        }
+        content.append(reinterpret_cast< const char* >(&value), sizeof(value));
+    };
+    auto block = [&](std::uint32_t type, auto body) {
+        const std::size_t start = content.size();
+        put(type);
+        put(std::uint32_t(0));
+        body();
+        content.append((4 - content.size() % 4) % 4, '\0');
+        const std::uint32_t length = content.size() - start + 4;
+        put(length);
+        std::memcpy(&content[start + 4], &content[content.size() - 4], 4);
+    };
+    auto option = [&](std::uint16_t code, auto value) {
+        put(code);
+        put(std::uint16_t(sizeof(value)));
+        put(value);
+        content.append((4 - sizeof(value) % 4) % 4, '\0');
+    };
+    auto interface = [&](std::uint16_t linktype, auto options) {
+        block(pcapng::InterfaceDescriptionBlock, [&] {
+            put(linktype);
+            put(std::uint16_t(0));
+            put(std::uint32_t(pcap::MaxSnapLen));
+            options();
+            put(std::uint32_t(0));
+        });
+    };
+    auto packet = [&](std::uint32_t id, std::uint64_t timestamp, std::size_t size, char fill) {
+        block(pcapng::EnhancedPacketBlock, [&] {
+            put(id);
+            put(std::uint32_t(timestamp >> 32));
+            put(std::uint32_t(timestamp));
+            put(std::uint32_t(size));
+            put(std::uint32_t(size));
+            content.append(size, fill);
+        });
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i == 0 || i == count / 2) {
+            swapped = i != 0;
+            block(pcapng::SectionHeaderBlock, [&] {
+                put(pcapng::ByteOrderMagic);
+                put(std::uint16_t(1));
+                put(std::uint16_t(0));
+                put(std::int64_t(-1));
+            });
+            interface(pcap::Ethernet, [&] { option(pcapng::IfTsResol, std::uint8_t(9)); });
+            interface(std::uint16_t(105), [] {});
+            interface(pcap::Ethernet, [&] {
+                option(pcapng::IfTsResol, std::uint8_t(0x80 | 30));
+                option(pcapng::IfTsOffset, std::int64_t(1));
+            });
+        }
+
+        if (i % 2 == 0) {
+            packet(0, i * 1000000000ull + i, i + 1, char(i));
+        } else {
+            // Smallest fraction of 2^-30 second not less than `i` nanoseconds
+            const std::uint64_t fraction = ((std::uint64_t(i) << 30) + 999999999) / 1000000000;
+            packet(2, (std::uint64_t(i - 1) << 30) + fraction, i + 1, char(i));
+        }
+        packet(1, 0, 14, 'x');
+        block(0x80000001, [&] { put(std::uint64_t(0)); });
+    }
+
+    return content;
+}
+
+/// Temporary file removed on scope exit
+class TempFile
+{
+private:
+    std::string path_;
+
+public:
+    TempFile(const std::string& content, const char* suffix = ".pcap")
+    {
+        char path[] = "/tmp/netbox_test_XXXXXX";
+        int fd = ::mkstemp(path);
+        EXPECT_NE( fd, -1 );
+        EXPECT_EQ( ::write(fd, content.data(), content.size()), ssize_t(content.size()) );
+        ::close(fd);
+        path_ = std::string{path} + suffix;
+        std::rename(path, path_.c_str());
+    }
+
+    ~TempFile()
+    {
+        std::remove(path_.c_str());
+    }
+
+    const char* path() const noexcept
+    {
+        return path_.c_str();
+    }
+};
+
+#if defined( netbox_PCAP_GZIP )
+/// GZip compress content
+std::string gzipCompress(const std::string& content)
+{
+    z_stream stream{};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS | 16, 8, Z_DEFAULT_STRATEGY);
+
+    std::string result(deflateBound(&stream, content.size()), '\0');
+    stream.next_in = reinterpret_cast< Bytef* >(const_cast< char* >(content.data()));
+    stream.avail_in = content.size();
+    stream.next_out = reinterpret_cast< Bytef* >(result.data());
+    stream.avail_out = result.size();
+    deflate(&stream, Z_FINISH);
+    result.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return result;
+}
+#endif // defined( netbox_PCAP_GZIP )
+
+#if defined( netbox_PCAP_LZMA )
+/// XZ compress content
+std::string xzCompress(const std::string& content)
+{
+    std::string result(lzma_stream_buffer_bound(content.size()), '\0');
+    std::size_t size = 0;
+    lzma_easy_buffer_encode(LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64, nullptr,
+            reinterpret_cast< const std::uint8_t* >(content.data()), content.size(),
+            reinterpret_cast< std::uint8_t* >(result.data()), &size, result.size());
+    result.resize(size);
+    return result;
+}
+
+/// XZ compress content into independent blocks of `blockSize`
+std::string xzCompressBlocks(const std::string& content, std::size_t blockSize)
+{
+    lzma_mt mt{};
+    mt.threads = 2;
+    mt.block_size = blockSize;
+    mt.preset = LZMA_PRESET_DEFAULT;
+    mt.check = LZMA_CHECK_CRC64;
+
+    lzma_stream stream = LZMA_STREAM_INIT;
+    if (lzma_stream_encoder_mt(&stream, &mt) != LZMA_OK) {
+        return {};
+    }
+
+    std::string result(lzma_stream_buffer_bound(content.size()), '\0');
+    stream.next_in = reinterpret_cast< const std::uint8_t* >(content.data());
+    stream.avail_in = content.size();
+    stream.next_out = reinterpret_cast< std::uint8_t* >(result.data());
+    stream.avail_out = result.size();
+    while (lzma_code(&stream, LZMA_FINISH) == LZMA_OK) {
+    }
+    result.resize(stream.total_out);
+    lzma_end(&stream);
+
+    return result;
+}
+#endif // defined( netbox_PCAP_LZMA )
+
+#if defined( netbox_PCAP_ZSTD )
+/// ZSTD compress content into frames of `frameSize`
+/// Seek table of seekable format appended if `seekable`
+std::string zstdCompress(const std::string& content, std::size_t frameSize, bool seekable = false)
+{
+    std::string result;
+    std::string table;
+
+    for (std::size_t offset = 0; offset < content.size(); offset += frameSize) {
+        const std::size_t size = std::min(frameSize, content.size() - offset);
+        std::string frame(ZSTD_compressBound(size), '\0');
+        frame.resize(ZSTD_compress(frame.data(), frame.size(), content.data() + offset, size, 3));
+        result += frame;
+
+        const std::uint32_t entry[] = {std::uint32_t(frame.size()), std::uint32_t(size)};
+        table.append(reinterpret_cast< const char* >(entry), sizeof(entry));
+    }
+
+    if (seekable) {
+        const std::uint32_t header[] = {0x184d2a5e, std::uint32_t(table.size() + 9)};
+        const std::uint32_t count = table.size() / 8;
+        const std::uint32_t magic = 0x8f92eab1;
+        result.append(reinterpret_cast< const char* >(header), sizeof(header));
+        result += table;
+        result.append(reinterpret_cast< const char* >(&count), sizeof(count));
+        result.push_back('\0');
+        result.append(reinterpret_cast< const char* >(&magic), sizeof(magic));
+    }
+
+    return result;
+}
+#endif // defined( netbox_PCAP_ZSTD )
+
+#if defined( netbox_PCAP_LZ4 )
+/// LZ4 compress content into single frame
+std::string lz4Compress(const std::string& content)
+{
+    std::string result(LZ4F_compressFrameBound(content.size(), nullptr), '\0');
+    result.resize(LZ4F_compressFrame(result.data(), result.size(), content.data(), content.size(), nullptr));
+    return result;
+}
+#endif // defined( netbox_PCAP_LZ4 )
+
+/// Read whole file content
+std::string readFile(const char* path)
+{
+    std::string content;
+    if (std::FILE* file = std::fopen(path, "rb"); file) {
+        char buffer[4096];
+        while (std::size_t count = std::fread(buffer, 1, sizeof(buffer), file)) {
+            content.append(buffer, count);
+        }
+        std::fclose(file);
+    }
+    return content;
+}
+
+template< class Reader >
+void checkPackets(Reader& reader, std::size_t count, std::uint32_t nsecScale = 1)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        auto packet = reader.readPacket();
+        ASSERT_TRUE( packet );
+        ASSERT_EQ( std::size_t(packet.timestamp().tv_sec), i );
+        ASSERT_EQ( std::size_t(packet.timestamp().tv_nsec), i * nsecScale );
+        ASSERT_EQ( packet.captureLength(), i + 1 );
+        ASSERT_EQ( packet.length(), i + 1 );
+        auto data = static_cast< const char* >(packet.data());
+        ASSERT_EQ( std::string(data, packet.captureLength()), std::string(i + 1, char(i)) );
+    }
+    ASSERT_FALSE( reader.readPacket() );
+    ASSERT_TRUE( reader.eof() );
+}
+
+} /* namespace */
+
+TEST(Pcap, Reader)
+{
+    TempFile file{makePcap(100)};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 100);
+}
+
+TEST(Pcap, ReaderMicroseconds)
+{
+    TempFile file{makePcap(10, pcap::TCPDumpMagic)};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 10, 1000);
+}
+
+TEST(Pcap, ReaderInvalid)
+{
+    TempFile file{std::string(64, 'x')};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_FALSE( reader );
+    ASSERT_FALSE( reader.readPacket() );
+}
+
+TEST(Pcap, ReaderNoFile)
+{
+    pcap::Reader reader{"/tmp/netbox_test_not_exists.pcap"};
+    ASSERT_FALSE( reader );
+    ASSERT_FALSE( reader.readPacket() );
+}
+
+TEST(Pcap, ReaderDirect)
+{
+    TempFile file{makePcap(300)};
+
+    utils::FileReaderOptions options;
+    options.direct = true;
+    options.bufferSize = 0;
+
+    pcap::Reader reader{file.path(), options};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 300);
+}
+
+#if defined( netbox_PCAP_GZIP )
+TEST(Pcap, ReaderGZip)
+{
+    // Concatenated members decoded as single stream
+    const std::string content = makePcap(300);
+    const std::size_t half = content.size() / 2;
+    TempFile file{gzipCompress(content.substr(0, half)) + gzipCompress(content.substr(half)), ".pcap.gz"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 300);
+}
+
+TEST(Pcap, ReaderGZipThread)
+{
+    TempFile file{gzipCompress(makePcap(1000)), ".pcap.gz"};
+
+    utils::FileReaderOptions options;
+    options.decompressThread = true;
+    options.decompressQueueDepth = 2;
+    options.decompressChunkSize = 4096;
+
+    pcap::Reader reader{file.path(), options};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 1000);
+
+    // Background thread stopped while running ahead
+    pcap::Reader partial{file.path(), options};
+    ASSERT_TRUE( partial.readPacket() );
+
+    // Chunks smaller than packets
+    options.decompressChunkSize = 100;
+    pcap::Reader small{file.path(), options};
+    ASSERT_TRUE( small );
+    checkPackets(small, 1000);
+}
+
+TEST(Pcap, GZipIndexSeek)
+{
+    // Concatenated members, checkpoints in both
+    std::string content = makePcap(2000);
+
+    // Poorly compressible payload, to get many deflate blocks
+    std::vector< std::uint64_t > offsets;
+    std::uint32_t seed = 1;
+    for (std::size_t offset = sizeof(pcap::FileHeader); offset < content.size();) {
+        offsets.push_back(offset);
+        pcap::PacketHeader header;
+        std::memcpy(&header, content.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        for (std::size_t i = 0; i < header.caplen; ++i) {
+            seed = seed * 1103515245 + 12345;
+            content[offset + i] = char(seed >> 16);
+        }
+        offset += header.caplen;
+    }
+
+    const std::size_t half = content.size() / 2;
+    TempFile file{gzipCompress(content.substr(0, half)) + gzipCompress(content.substr(half)), ".pcap.gz"};
+    const std::string indexPath = std::string{file.path()} + ".gzidx";
+
+    auto index = pcap::GZipIndex::build(file.path(), 64 * 1024);
+    ASSERT_GT( index.size(), 10u );
+    ASSERT_TRUE( index.save(indexPath.c_str(), file.path()) );
+
+    // Data decompressed from checkpoint matches original
+    for (std::size_t i = 0; i < index.size(); ++i) {
+        const auto& checkpoint = index[i];
+        utils::FileReader reader{pcap::GZipIndex::open(file.path(), checkpoint)};
+        std::string data(content.size() - checkpoint.output, '\0');
+        ASSERT_EQ( reader.read(data.data(), data.size()), data.size() );
+        ASSERT_EQ( data, content.substr(checkpoint.output) );
+    }
+
+    // Reader uses saved index
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    for (std::size_t seconds: {1500u, 10u, 1999u, 0u, 1000u}) {
+        ASSERT_TRUE( reader.seek(seconds * 1000000000ull) );
+        ASSERT_EQ( reader.tell(), offsets[seconds] );
+        for (std::size_t i = seconds; i < std::min< std::size_t >(seconds + 10, 2000); ++i) {
+            auto packet = reader.readPacket();
+            ASSERT_TRUE( packet );
+            ASSERT_EQ( std::size_t(packet.timestamp().tv_sec), i );
+            ASSERT_EQ( packet.captureLength(), i + 1 );
+        }
+    }
+    ASSERT_FALSE( reader.seek(2000 * 1000000000ull) );
+    ASSERT_TRUE( reader.seek(0) );
+    ASSERT_EQ( std::size_t(reader.readPacket().timestamp().tv_sec), 0u );
+
+    std::remove(indexPath.c_str());
+}
+#endif // defined( netbox_PCAP_GZIP )
+
+#if defined( netbox_PCAP_LZMA )
+TEST(Pcap, ReaderLZMA)
+{
+    TempFile file{xzCompress(makePcap(300)), ".pcap.xz"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 300);
+}
+
+TEST(Pcap, ReaderLZMAThreads)
+{
+    const std::string content = makePcap(2000);
+    TempFile multiBlock{xzCompressBlocks(content, 64 * 1024), ".pcap.xz"};
+    TempFile singleBlock{xzCompress(content), ".pcap.xz"};
+
+    utils::FileReaderOptions options;
+    options.decompressThreads = 4;
+
+    for (const char* path: {multiBlock.path(), singleBlock.path()}) {
+        pcap::Reader reader{path, options};
+        ASSERT_TRUE( reader );
+        checkPackets(reader, 2000);
+        ASSERT_FALSE( reader.readPacket() );
+    }
+
+    // Memory limit too low for threads, decoded by one thread
+    options.decompressMemoryLimit = 1;
+    pcap::Reader reader{multiBlock.path(), options};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 2000);
+}
+#endif // defined( netbox_PCAP_LZMA )
+
+#if defined( netbox_PCAP_ZSTD )
+TEST(Pcap, ReaderZSTD)
+{
+    TempFile file{zstdCompress(makePcap(2000), 64 * 1024), ".pcap.zst"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 2000);
+    ASSERT_FALSE( reader.readPacket() );
+}
+
+TEST(Pcap, ReaderZSTDSeekable)
+{
+    const std::string content = makePcap(2000);
+    TempFile file{zstdCompress(content, 64 * 1024, true), ".pcap.zst"};
+
+    // Streaming decoder skips the seek table
+    {
+        pcap::Reader reader{file.path()};
+        ASSERT_TRUE( reader );
+        checkPackets(reader, 2000);
+        ASSERT_FALSE( reader.readPacket() );
+    }
+
+    utils::FileReaderOptions options;
+    options.decompressThreads = 3;
+    {
+        pcap::Reader reader{file.path(), options};
+        ASSERT_TRUE( reader );
+        checkPackets(reader, 2000);
+        ASSERT_FALSE( reader.readPacket() );
+    }
+
+    // Stop in the middle
+    {
+        pcap::Reader reader{file.path(), options};
+        for (std::size_t i = 0; i < 10; ++i) {
+            ASSERT_TRUE( reader.readPacket() );
+        }
+    }
+
+    // Corrupted frame
+    std::string corrupted = zstdCompress(content, 64 * 1024, true);
+    corrupted[corrupted.size() / 2] ^= 0x5a;
+    TempFile corruptedFile{corrupted, ".pcap.zst"};
+    auto readAll = [&] {
+        pcap::Reader reader{corruptedFile.path(), options};
+        while (reader.readPacket()) {
+        }
+    };
+    ASSERT_THROW( readAll(), std::runtime_error );
+}
+#endif // defined( netbox_PCAP_ZSTD )
+
+#if defined( netbox_PCAP_LZ4 )
+TEST(Pcap, ReaderLZ4)
+{
+    // Concatenated frames
+    const std::string content = makePcap(2000);
+    const std::size_t half = content.size() / 2;
+    TempFile file{lz4Compress(content.substr(0, half)) + lz4Compress(content.substr(half)), ".pcap.lz4"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 2000);
+}
+#endif // defined( netbox_PCAP_LZ4 )
+
+#if defined( netbox_PCAP_GZIP )
+TEST(Pcap, ReaderDetectCompression)
+{
+    // Compression detected by magic bytes, not by suffix
+    TempFile file{gzipCompress(makePcap(300)), ".pcap"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 300);
+
+    // Seek uses gzip checkpoint index
+    const std::string indexPath = std::string{file.path()} + ".gzidx";
+    ASSERT_TRUE( reader.seek(150 * 1000000000ull) );
+    ASSERT_EQ( reader.readPacket().timestamp().tv_sec, 150 );
+    ASSERT_EQ( ::access(indexPath.c_str(), F_OK), 0 );
+    std::remove(indexPath.c_str());
+}
+#endif // defined( netbox_PCAP_GZIP )
+
+TEST(Pcap, ReaderSeek)
+{
+    TempFile file{makePcap(100)};
+    const std::string indexPath = std::string{file.path()} + ".tsidx";
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    ASSERT_TRUE( reader.seek(50 * 1000000000ull + 100) );
+
+    pcap::Packet packets[8];
+    ASSERT_EQ( reader.readPackets(packets, 8), 8u );
+    for (std::size_t i = 0; i < 8; ++i) {
+        ASSERT_EQ( std::size_t(packets[i].timestamp().tv_sec), 51 + i );
+        ASSERT_EQ( packets[i].captureLength(), 52 + i );
+    }
+
+    std::remove(indexPath.c_str());
+}
+
+TEST(Pcap, ReaderSeekTimeIndex)
+{
+    // About 4.5MiB, several index entries
+    TempFile file{makePcap(3000)};
+    const std::string indexPath = std::string{file.path()} + ".tsidx";
+
+    utils::FileReaderOptions direct;
+    direct.direct = true;
+
+    for (const auto& options: {utils::FileReaderOptions{}, direct}) {
+        pcap::Reader reader{file.path(), options};
+        ASSERT_TRUE( reader );
+        for (std::size_t seconds: {2500, 10, 0, 1700, 2999, 1024}) {
+            ASSERT_TRUE( reader.seek(seconds * 1000000000ull) );
+            for (std::size_t i = seconds; i < std::min< std::size_t >(seconds + 10, 3000); ++i) {
+                auto packet = reader.readPacket();
+                ASSERT_TRUE( packet );
+                ASSERT_EQ( std::size_t(packet.timestamp().tv_sec), i );
+                auto data = static_cast< const char* >(packet.data());
+                ASSERT_EQ( std::string(data, packet.captureLength()), std::string(i + 1, char(i)) );
+            }
+        }
+        ASSERT_FALSE( reader.seek(3000 * 1000000000ull) );
+        ASSERT_FALSE( reader.readPacket() );
+
+        // Readable after seek past the end
+        ASSERT_TRUE( reader.seek(0) );
+        checkPackets(reader, 3000);
+    }
+
+    pcap::TimeIndex index;
+    ASSERT_TRUE( index.load(indexPath.c_str(), file.path()) );
+    ASSERT_GT( index.size(), 3u );
+    ASSERT_EQ( index[0].offset, sizeof(pcap::FileHeader) );
+    ASSERT_NE( ::access((indexPath + ".tmp").c_str(), F_OK), 0 );
+
+    // Truncated or corrupt index is rejected and rebuilt
+    for (std::uint64_t count: {std::uint64_t(1) << 60, std::uint64_t(index.size() - 1)}) {
+        std::FILE* sidecar = std::fopen(indexPath.c_str(), "r+b");
+        ASSERT_TRUE( sidecar );
+        // Count follows magic, file size and time
+        std::fseek(sidecar, 24, SEEK_SET);
+        std::fwrite(&count, sizeof(count), 1, sidecar);
+        std::fclose(sidecar);
+        ASSERT_FALSE( index.load(indexPath.c_str(), file.path()) );
+
+        pcap::Reader reader{file.path()};
+        ASSERT_TRUE( reader.seek(1700 * 1000000000ull) );
+        ASSERT_EQ( std::size_t(reader.readPacket().timestamp().tv_sec), 1700u );
+        ASSERT_TRUE( index.load(indexPath.c_str(), file.path()) );
+    }
+
+    std::remove(indexPath.c_str());
+}
+
+TEST(Pcap, ReaderPcapng)
+{
+    TempFile file{makePcapng(300), ".pcapng"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 300);
+
+    pcap::Reader batchReader{file.path()};
+    auto batch = batchReader.readBatch(200);
+    ASSERT_EQ( batch.size(), 200u );
+    ASSERT_EQ( batchReader.readBatch(200).size(), 100u );
+
+    ASSERT_TRUE( reader.seek(250 * 1000000000ull) );
+    auto packet = reader.readPacket();
+    ASSERT_TRUE( packet );
+    ASSERT_EQ( packet.timestamp().tv_sec, 250 );
+    ASSERT_EQ( packet.timestamp().tv_nsec, 250 );
+}
+
+#if defined( netbox_PCAP_GZIP )
+TEST(Pcap, ReaderPcapngGZip)
+{
+    TempFile file{gzipCompress(makePcapng(300)), ".pcapng.gz"};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 300);
+}
+#endif // defined( netbox_PCAP_GZIP )
+
+TEST(Pcap, MappedReaderInvalid)
+{
+    TempFile file{std::string(64, 'x')};
+
+    pcap::MappedReader reader{file.path()};
+    ASSERT_FALSE( reader );
+}
+
+TEST(Pcap, MappedReader)
+{
+    TempFile file{makePcap(100)};
+
+    pcap::MappedReader reader{file.path()};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 100);
+}
+
+TEST(Pcap, MappedReaderBuffer)
+{
+    const std::string content = makePcap(10, pcap::TCPDumpMagic);
+
+    pcap::MappedReader reader{ConstBuffer{content.data(), content.size()}};
+    ASSERT_TRUE( reader );
+    checkPackets(reader, 10, 1000);
+}
+
+TEST(Pcap, MappedReaderTruncated)
+{
+    std::string content = makePcap(10);
+    content.resize(content.size() - 4);
+
+    pcap::MappedReader reader{ConstBuffer{content.data(), content.size()}};
+    ASSERT_TRUE( reader );
+    for (std::size_t i = 0; i < 9; ++i) {
+        ASSERT_TRUE( reader.readPacket() );
+    }
+    ASSERT_FALSE( reader.readPacket() );
+    ASSERT_TRUE( reader.eof() );
+}
+
+TEST(Pcap, Writer)
+{
+    const std::string content = makePcap(300);
+    TempFile input{content};
+    TempFile output{""};
+
+    utils::FileWriterOptions options;
+    options.bufferSize = 4096;
+
+    {
+        pcap::Reader reader{input.path()};
+        pcap::Writer writer{output.path(), options};
+        ASSERT_TRUE( writer );
+        for (auto batch = reader.readBatch(7); !batch.empty(); batch = reader.readBatch(7)) {
+            writer.write(batch);
+        }
+    }
+    ASSERT_EQ( readFile(output.path()), content );
+
+    // Truncated to snaplen
+    {
+        pcap::Reader reader{input.path()};
+        pcap::Writer writer{output.path(), options, 100};
+        while (auto packet = reader.readPacket()) {
+            writer.write(packet);
+        }
+        writer.close();
+
+        pcap::Reader result{output.path()};
+        for (std::size_t i = 0; i < 300; ++i) {
+            auto packet = result.readPacket();
+            ASSERT_TRUE( packet );
+            ASSERT_EQ( packet.captureLength(), std::min< std::size_t >(i + 1, 100) );
+            ASSERT_EQ( packet.length(), i + 1 );
+        }
+        ASSERT_FALSE( result.readPacket() );
+    }
+}
+
+TEST(Pcap, WriterCompressed)
+{
+    TempFile input{makePcap(1000)};
+
+    std::vector< const char* > suffixes;
+#if defined( netbox_PCAP_GZIP )
+    suffixes.push_back(".pcap.gz");
+#endif // defined( netbox_PCAP_GZIP )
+#if defined( netbox_PCAP_ZSTD )
+    suffixes.push_back(".pcap.zst");
+#endif // defined( netbox_PCAP_ZSTD )
+
+    for (auto suffix: suffixes) {
+        for (bool thread: {false, true}) {
+            TempFile output{"", suffix};
+
+            utils::FileWriterOptions options;
+            options.compressThread = thread;
+            options.compressChunkSize = 64 * 1024;
+            options.compressQueueDepth = 2;
+
+            pcap::Reader reader{input.path()};
+            pcap::Writer writer{output.path(), options};
+            while (auto packet = reader.readPacket()) {
+                writer.write(packet);
+            }
+            writer.close();
+
+            pcap::Reader result{output.path()};
+            ASSERT_TRUE( result );
+            checkPackets(result, 1000);
+        }
+    }
+}
+
+TEST(Pcap, ReaderBatch)
+{
+    TempFile file{makePcap(100)};
+
+    pcap::Reader reader{file.path()};
+    ASSERT_TRUE( reader );
+
+    std::size_t index = 0;
+    for (auto batch = reader.readBatch(16); !batch.empty(); batch = reader.readBatch(16)) {
+        ASSERT_EQ( batch.size(), std::min< std::size_t >(16, 100 - index) );
+        for (auto& packet: batch) {
+            ASSERT_EQ( std::size_t(packet.timestamp().tv_sec), index );
+            auto data = static_cast< const char* >(packet.data());
+            ASSERT_EQ( std::string(data, packet.captureLength()), std::string(index + 1, char(index)) );
+            index += 1;
+        }
+    }
+    ASSERT_EQ( index, 100u );
+}
+
+TEST(Pcap, MappedReaderBatch)
+{
+    const std::string content = makePcap(100);
+
+    pcap::MappedReader reader{ConstBuffer{content.data(), content.size()}};
+    ASSERT_TRUE( reader );
+
+    pcap::Packet packets[64];
+    ASSERT_EQ( reader.readPackets(packets, 64), 64u );
+    ASSERT_EQ( reader.readPackets(packets, 64), 36u );
+    ASSERT_EQ( packets[35].captureLength(), 100u );
+    ASSERT_EQ( reader.readPackets(packets, 64), 0u );
+}
+
+TEST(Pcap, PacketSourceBatch)
+{
+    TempFile file1{makePcap(50)};
+    TempFile file2{makePcap(50)};
+
+    PcapPacketSource source;
+    source.addFile(file1.path());
+    source.addFile(file2.path());
+
+    std::size_t count = 0;
+    std::uint64_t lastTime = 0;
+    for (auto batch = source.readBatch(32); !batch.empty(); batch = source.readBatch(32)) {
+        for (auto& packet: batch) {
+            const auto time = details::makeUnixTimeNs(packet.timestamp());
+            ASSERT_LE( lastTime, time );
+            lastTime = time;
+
+            // Packets data stays valid through the whole batch
+            const std::size_t index = packet.timestamp().tv_sec;
+            auto data = static_cast< const char* >(packet.data());
+            ASSERT_EQ( std::string(data, packet.captureLength()), std::string(index + 1, char(index)) );
+            count += 1;
+        }
+    }
+    ASSERT_EQ( count, 100u );
+    ASSERT_TRUE( source.isDone() );
+}
+
+TEST(Pcap, PacketSourceMerge)
+{
+    TempFile file1{makePcap({0, 1, 2, 3, 10, 11, 12}, 'a')};
+    TempFile file2{makePcap({1, 4, 5, 6, 7}, 'b')};
+    TempFile file3{makePcap({1, 20}, 'c')};
+    TempFile file4{makePcap(std::vector< std::uint32_t >{}, 'd')};
+
+    PcapPacketSourceOptions prefetch;
+    prefetch.prefetchThreads = 2;
+
+    for (const auto& options: {PcapPacketSourceOptions{}, prefetch}) {
+        PcapPacketSource source{options};
+        source.addFile(file1.path());
+        source.addFile(file2.path());
+        source.addFile(file3.path());
+        source.addFile(file4.path());
+
+        std::size_t doneCount = 0;
+        source.setDoneCallback([&doneCount] { doneCount += 1; });
+
+        // Equal timestamps ordered by file
+        const std::string expected = "0a1a1b1c2a3a4b5b6b7b10a11a12a20c";
+        std::string merged;
+        while (auto packet = source.readNextPacket()) {
+            merged += std::to_string(packet.timestamp().tv_sec);
+            merged += *static_cast< const char* >(packet.data());
+        }
+        ASSERT_EQ( merged, expected );
+        ASSERT_TRUE( source.isDone() );
+        ASSERT_EQ( doneCount, 1u );
+    }
+}
+
+TEST(Pcap, PacketSourcePcapng)
+{
+    TempFile file1{makePcap(100)};
+    TempFile file2{makePcapng(100), ".pcapng"};
+
+    PcapPacketSourceOptions prefetch;
+    prefetch.prefetchThreads = 2;
+
+    for (const auto& options: {PcapPacketSourceOptions{}, prefetch}) {
+        PcapPacketSource source{options};
+        source.addFile(file1.path());
+        source.addFile(file2.path());
+
+        for (std::size_t i = 0; i < 200; ++i) {
+            auto packet = source.readNextPacket();
+            ASSERT_TRUE( packet );
+            ASSERT_EQ( std::size_t(packet.timestamp().tv_sec), i / 2 );
+            ASSERT_EQ( std::size_t(packet.timestamp().tv_nsec), i / 2 );
+            ASSERT_EQ( packet.captureLength(), i / 2 + 1 );
+        }
+        ASSERT_FALSE( source.readNextPacket() );
+        ASSERT_TRUE( source.isDone() );
+    }
+}
+
+TEST(Pcap, PacketSourcePrefetch)
+{
+    std::vector< std::unique_ptr< TempFile > > files;
+    for (std::size_t i = 0; i < 6; ++i) {
+        files.push_back(std::make_unique< TempFile >(makePcap(2000)));
+    }
+
+    // Few small blocks, workers stall on full files
+    PcapPacketSourceOptions options;
+    options.prefetchThreads = 3;
+    options.prefetchBlockSize = 1;
+    options.prefetchBlockCount = 2;
+
+    PcapPacketSource source{options};
+    for (auto& file: files) {
+        source.addFile(file->path());
+    }
+
+    std::size_t count = 0;
+    std::uint64_t lastTime = 0;
+    while (auto packet = source.readNextPacket()) {
+        const auto time = details::makeUnixTimeNs(packet.timestamp());
+        ASSERT_LE( lastTime, time );
+        lastTime = time;
+
+        const std::size_t index = packet.timestamp().tv_sec;
+        auto data = static_cast< const char* >(packet.data());
+        ASSERT_EQ( std::string(data, packet.captureLength()), std::string(index + 1, char(index)) );
+        count += 1;
+    }
+    ASSERT_EQ( count, 6 * 2000u );
+
+    // Stop with workers running
+    PcapPacketSource partial{options};
+    for (auto& file: files) {
+        partial.addFile(file->path());
+    }
+    ASSERT_TRUE( partial.readNextPacket() );
+}
+
+#if defined( netbox_PCAP_GZIP )
+TEST(Pcap, PacketSourcePrefetchError)
+{
+    // Broken CRC, detected at the end of data
+    std::string content = gzipCompress(makePcap(2000));
+    content[content.size() - 8] ^= 0x5a;
+    TempFile file{content, ".pcap.gz"};
+
+    PcapPacketSourceOptions options;
+    options.prefetchThreads = 1;
+
+    auto readAll = [&] {
+        PcapPacketSource source{options};
+        source.addFile(file.path());
+        while (source.readNextPacket()) {
+        }
+    };
+    ASSERT_THROW( readAll(), std::runtime_error );
+}
+#endif // defined( netbox_PCAP_GZIP )
+
+TEST(Pcap, PacketPool)
+{
+    const std::string small(100, 's');
+    const std::string large(5000, 'l');
+
+    std::vector< pcap::PooledPacket > packets;
+    {
+        pcap::PacketPool pool{256, 4096};
+
+        ASSERT_FALSE( pool.copy(pcap::Packet{}) );
+
+        for (std::size_t i = 0; i < 100; ++i) {
+            const std::string& data = (i % 10 == 0) ? large : small;
+            const pcap::Packet packet{timespec{time_t(i), 0}, std::uint32_t(data.size()), 9000, data.data()};
+            packets.push_back(pool.copy(packet));
+        }
+
+        // Released buffers reused once free ones run out
+        const void* address = packets[1]->data();
+        packets[1] = {};
+        bool reused = false;
+        std::vector< pcap::PooledPacket > more;
+        while (!reused && more.size() < 100) {
+            more.push_back(pool.copy(pcap::Packet{timespec{1, 0}, std::uint32_t(small.size()), 9000, small.data()}));
+            reused = more.back()->data() == address;
+        }
+        ASSERT_TRUE( reused );
+        packets[1] = std::move(more.back());
+
+        // Release from other thread
+        std::thread thread{[moved = std::move(packets[2])] {}};
+        thread.join();
+        ASSERT_FALSE( packets[2] );
+        packets[2] = pool.copy(pcap::Packet{timespec{2, 0}, std::uint32_t(small.size()), 9000, small.data()});
+    }
+
+    // Packets outlive pool
+    for (std::size_t i = 0; i < packets.size(); ++i) {
+        const std::string& data = (i % 10 == 0) ? large : small;
+        ASSERT_EQ( std::size_t(packets[i]->timestamp().tv_sec), i );
+        ASSERT_EQ( packets[i]->length(), 9000u );
+        ASSERT_EQ( std::string(static_cast< const char* >(packets[i]->data()), packets[i]->captureLength()), data );
+    }
+
+    // Retain
+    pcap::PooledPacket copy = packets[5];
+    packets.clear();
+    ASSERT_EQ( std::string(static_cast< const char* >(copy->data()), copy->captureLength()), small );
+}
+
+TEST(Pcap, PacketSourcePooled)
+{
+    TempFile file1{makePcap(500)};
+    TempFile file2{makePcap(500)};
+
+    PcapPacketSource source;
+    source.addFile(file1.path());
+    source.addFile(file2.path());
+
+    std::vector< pcap::PooledPacket > packets;
+    while (auto packet = source.readNextPooledPacket()) {
+        packets.push_back(std::move(packet));
+    }
+    ASSERT_EQ( packets.size(), 1000u );
+    ASSERT_TRUE( source.isDone() );
+
+    for (std::size_t i = 0; i < packets.size(); ++i) {
+        const std::size_t index = i / 2;
+        ASSERT_EQ( std::size_t(packets[i]->timestamp().tv_sec), index );
+        auto data = static_cast< const char* >(packets[i]->data());
+        ASSERT_EQ( std::string(data, packets[i]->captureLength()), std::string(index + 1, char(index)) );
+    }
+}
+
+TEST(Pcap, PacketSourceSeek)
+{
+    TempFile file1{makePcap(2000)};
+    TempFile file2{makePcap(1000)};
+
+    PcapPacketSourceOptions prefetch;
+    prefetch.prefetchThreads = 2;
+
+    for (const auto& options: {PcapPacketSourceOptions{}, prefetch}) {
+        PcapPacketSource source{options};
+        source.addFile(file1.path());
+        source.addFile(file2.path());
+
+        // Both files, then the longer one only
+        for (std::size_t seconds: {500, 1500, 20}) {
+            ASSERT_TRUE( source.seek(seconds * 1000000000ull) );
+            const std::size_t copies = seconds < 1000 ? 2 : 1;
+            for (std::size_t i = 0; i < 10 * copies; ++i) {
+                auto packet = source.readNextPacket();
+                ASSERT_TRUE( packet );
+                ASSERT_EQ( std::size_t(packet.timestamp().tv_sec), seconds + i / copies );
+            }
+        }
+
+        ASSERT_FALSE( source.seek(2000 * 1000000000ull) );
+        ASSERT_TRUE( source.isDone() );
+        ASSERT_FALSE( source.readNextPacket() );
+
+        ASSERT_TRUE( source.seek(1999 * 1000000000ull) );
+        ASSERT_TRUE( source.readNextPacket() );
+        ASSERT_FALSE( source.readNextPacket() );
+    }
+
+    std::remove((std::string{file1.path()} + ".tsidx").c_str());
+    std::remove((std::string{file2.path()} + ".tsidx").c_str());
+}
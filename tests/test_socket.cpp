@@ -0,0 +1,555 @@
+// ------------------------------------------------------------
+// Copyright 2026-present Sergey Kovalevich <inndie@gmail.com>
+// ------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <netbox/IoUring.h>
+#include <netbox/MessageBatch.h>
+#include <netbox/Reactor.h>
+#include <netbox/ReusePortGroup.h>
+#include <netbox/socket_ops.h>
+#include <netbox/socket_options.h>
+#include <netbox/TxTimestamper.h>
+#include <netbox/ZeroCopySender.h>
+
+using namespace netbox;
+
+namespace {
+
+/// Create UDP socket bound to loopback ephemeral port
+Socket bindLoopback(IPv4::Endpoint& endpoint)
+{
+    auto socket = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    if (!bind(socket, IPv4::Endpoint{IPv4::Address::loopback(), 0})) {
+        throw std::runtime_error("bind");
+    }
+    socklen_t size = endpoint.size();
+    ::getsockname(socket.native(), endpoint.data(), &size);
+    return socket;
+}
+
+} /* namespace */
+
+TEST(Socket, MessageBatch)
+{
+    IPv4::Endpoint receiverEndpoint;
+    IPv4::Endpoint senderEndpoint;
+    auto receiver = bindLoopback(receiverEndpoint);
+    auto sender = bindLoopback(senderEndpoint);
+    ASSERT_TRUE( setOption(receiver, Options::Socket::TimestampNS{true}) );
+
+    MessageBatch output{8, 64};
+    ASSERT_TRUE( output.empty() );
+    ASSERT_FALSE( output.push(std::string(65, 'x').data(), 65, receiverEndpoint) );
+    for (std::size_t i = 0; !output.full(); ++i) {
+        const std::string payload = "message-" + std::to_string(i);
+        ASSERT_TRUE( output.push(payload.data(), payload.size(), receiverEndpoint) );
+    }
+    ASSERT_FALSE( output.push("x", 1, receiverEndpoint) );
+
+    auto sent = sendBatch(sender, output);
+    ASSERT_TRUE( sent );
+    ASSERT_EQ( sent.bytes(), 8u );
+    ASSERT_EQ( output.length(0), 9u );
+
+    // Receive in two batches, the first one truncates messages
+    MessageBatch input{5, 8};
+    std::size_t received = 0;
+    while (received < 8) {
+        auto result = recvBatch(receiver, input, MSG_WAITFORONE);
+        ASSERT_TRUE( result );
+        ASSERT_EQ( input.size(), result.bytes() );
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            const std::string payload = "message-" + std::to_string(received);
+            ASSERT_EQ( input.length(i), 8u );
+            ASSERT_TRUE( input.truncated(i) );
+            ASSERT_EQ( std::string(static_cast< const char* >(input.data(i)), 8), payload.substr(0, 8) );
+            ASSERT_EQ( input.endpoint< IPv4::Endpoint >(i).port(), senderEndpoint.port() );
+            ASSERT_GT( input.timestamp(i).tv_sec, 0 );
+            received += 1;
+        }
+    }
+
+    // Reused batch is reset
+    ASSERT_FALSE( output.empty() );
+    output.clear();
+    ASSERT_TRUE( output.push("ping", 4, receiverEndpoint) );
+    ASSERT_EQ( sendBatch(sender, output).bytes(), 1u );
+    MessageBatch large{4};
+    ASSERT_TRUE( recvBatch(receiver, large, MSG_WAITFORONE) );
+    ASSERT_EQ( large.size(), 1u );
+    ASSERT_EQ( large.length(0), 4u );
+    ASSERT_FALSE( large.truncated(0) );
+    ASSERT_EQ( std::memcmp(large.data(0), "ping", 4), 0 );
+}
+
+TEST(Socket, ReceiveTimestamps)
+{
+    IPv4::Endpoint receiverEndpoint;
+    IPv4::Endpoint senderEndpoint;
+    auto receiver = bindLoopback(receiverEndpoint);
+    auto sender = bindLoopback(senderEndpoint);
+    ASSERT_TRUE( setOption(receiver, Options::Socket::Timestamping{
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE}) );
+
+    timespec before;
+    ::clock_gettime(CLOCK_REALTIME, &before);
+    ASSERT_TRUE( sendto(sender, "ping", 4, receiverEndpoint.data(), receiverEndpoint.size()) );
+    ASSERT_TRUE( sendto(sender, "pong", 4, receiverEndpoint.data(), receiverEndpoint.size()) );
+
+    char buffer[16];
+    ReceiveTimestamps timestamps;
+    IPv4::Endpoint source;
+    socklen_t sourceSize = source.size();
+    auto result = recvmsg(receiver, buffer, sizeof(buffer), timestamps, source.data(), &sourceSize);
+    ASSERT_EQ( result.bytes(), 4u );
+    ASSERT_EQ( sourceSize, source.size() );
+    ASSERT_EQ( source.port(), senderEndpoint.port() );
+    ASSERT_TRUE( timestamps.hasSoftware() );
+    ASSERT_FALSE( timestamps.hasHardware() );
+    ASSERT_GE( timestamps.software.tv_sec, before.tv_sec );
+
+    MessageBatch batch{4};
+    ASSERT_EQ( recvBatch(receiver, batch, MSG_WAITFORONE).bytes(), 1u );
+    std::size_t found = 0;
+    for (auto cmsg: batch.controlMessages(0)) {
+        found += cmsg.is(SOL_SOCKET, SCM_TIMESTAMPING);
+    }
+    ASSERT_EQ( found, 1u );
+    const auto batchTimestamps = batch.timestamps(0);
+    ASSERT_TRUE( batchTimestamps.hasSoftware() );
+    ASSERT_GE( batchTimestamps.software.tv_sec * 1000000000 + batchTimestamps.software.tv_nsec,
+            timestamps.software.tv_sec * 1000000000 + timestamps.software.tv_nsec );
+}
+
+TEST(Socket, TxTimestamper)
+{
+    IPv4::Endpoint receiverEndpoint;
+    IPv4::Endpoint senderEndpoint;
+    auto receiver = bindLoopback(receiverEndpoint);
+    auto sender = bindLoopback(senderEndpoint);
+
+    TxTimestamper timestamper{sender, true};
+
+    constexpr std::uint32_t Count = 10;
+    for (std::uint32_t i = 0; i < Count; ++i) {
+        if (i % 2 == 0) {
+            ASSERT_EQ( timestamper.record(), i );
+            ASSERT_TRUE( sendto(sender, &i, sizeof(i), receiverEndpoint.data(), receiverEndpoint.size()) );
+        } else {
+            ASSERT_TRUE( timestamper.sendto(&i, sizeof(i), receiverEndpoint.data(), receiverEndpoint.size()) );
+            ASSERT_EQ( timestamper.next(), i + 1 );
+        }
+
+        // Failed sends are not numbered by the kernel
+        ASSERT_FALSE( timestamper.sendto(&i, sizeof(i), receiverEndpoint.data(), 1) );
+        timestamper.record();
+        ASSERT_FALSE( sendto(sender, &i, sizeof(i), receiverEndpoint.data(), 1) );
+        timestamper.cancel();
+        ASSERT_EQ( timestamper.next(), i + 1 );
+    }
+
+    std::vector< TxTimestamp > sched;
+    std::vector< TxTimestamp > software;
+    while (software.size() < Count && timestamper.wait(1000)) {
+        timestamper.drain([&](const TxTimestamp& timestamp) {
+            (timestamp.type == TxTimestampType::Sched ? sched : software).push_back(timestamp);
+        });
+    }
+
+    ASSERT_EQ( software.size(), Count );
+    ASSERT_EQ( sched.size(), Count );
+    for (std::uint32_t i = 0; i < Count; ++i) {
+        ASSERT_EQ( software[i].id, i );
+        ASSERT_EQ( sched[i].id, i );
+        ASSERT_GE( software[i].latency(), 0 );
+        ASSERT_GT( software[i].sent.tv_sec, 0 );
+        ASSERT_GE( software[i].latency(), sched[i].latency() );
+    }
+}
+
+TEST(Socket, Reactor)
+{
+    IPv4::Endpoint firstEndpoint;
+    IPv4::Endpoint secondEndpoint;
+    auto first = bindLoopback(firstEndpoint);
+    auto second = bindLoopback(secondEndpoint);
+    auto sender = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_TRUE( first.setNonBlocking() );
+    ASSERT_TRUE( second.setNonBlocking() );
+
+    Reactor reactor{4};
+
+    // Level triggered, reads one datagram per notification
+    std::size_t firstReceived = 0;
+    auto onFirst = [&](std::uint32_t events) {
+        ASSERT_TRUE( events & Reactor::Readable );
+        char buffer[16];
+        if (recv(first, buffer, sizeof(buffer))) {
+            firstReceived += 1;
+        }
+    };
+    // Edge triggered, drains the socket
+    std::size_t secondReceived = 0;
+    Reactor::Handle secondHandle;
+    auto onSecond = [&](std::uint32_t) {
+        char buffer[16];
+        while (recv(second, buffer, sizeof(buffer))) {
+            secondReceived += 1;
+        }
+        // Removed from its own handler
+        ASSERT_TRUE( reactor.remove(secondHandle) );
+    };
+    reactor.add(first, Reactor::Readable, Reactor::Trigger::Level, onFirst);
+    secondHandle = reactor.add(second, Reactor::Readable, Reactor::Trigger::Edge, onSecond);
+
+    for (int i = 0; i < 3; ++i) {
+        sendto(sender, "x", 1, firstEndpoint.data(), firstEndpoint.size());
+        sendto(sender, "y", 1, secondEndpoint.data(), secondEndpoint.size());
+    }
+    while (firstReceived < 3) {
+        ASSERT_GT( reactor.poll(1000), 0 );
+    }
+    ASSERT_EQ( secondReceived, 3u );
+    ASSERT_FALSE( reactor.remove(secondHandle) );
+
+    // Timers fire in deadline order, cancelled timer doesn't fire
+    std::vector< int > fired;
+    auto timer1 = [&] { fired.push_back(1); };
+    auto timer2 = [&] { fired.push_back(2); };
+    auto timer3 = [&] {
+        fired.push_back(3);
+        reactor.stop();
+    };
+    reactor.addTimer(std::chrono::milliseconds{20}, timer2);
+    reactor.addTimer(std::chrono::milliseconds{40}, timer3);
+    reactor.addTimer(std::chrono::milliseconds{1}, timer1);
+    auto cancelled = reactor.addTimer(std::chrono::milliseconds{10}, timer1);
+    ASSERT_TRUE( reactor.cancelTimer(cancelled) );
+    ASSERT_FALSE( reactor.cancelTimer(cancelled) );
+    ASSERT_EQ( reactor.pendingTimers(), 3u );
+
+    // Re-armed timeout doesn't accumulate cancelled timers
+    cancelled = reactor.addTimer(std::chrono::seconds{1}, timer1);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE( reactor.cancelTimer(std::exchange(cancelled, reactor.addTimer(std::chrono::seconds{1}, timer1))) );
+    }
+    ASSERT_TRUE( reactor.cancelTimer(cancelled) );
+    ASSERT_EQ( reactor.pendingTimers(), 3u );
+
+    const auto start = std::chrono::steady_clock::now();
+    reactor.run();
+    ASSERT_GE( std::chrono::steady_clock::now() - start, std::chrono::milliseconds{40} );
+    ASSERT_EQ( fired, (std::vector< int >{1, 2, 3}) );
+    ASSERT_EQ( reactor.pendingTimers(), 0u );
+
+    // Timers cancelled from the middle of heap
+    struct Probe
+    {
+        std::vector< int >* fired;
+        int delay;
+
+        void operator()()
+        {
+            fired->push_back(delay);
+        }
+    };
+    fired.clear();
+    std::vector< Probe > probes;
+    std::vector< Reactor::Handle > handles;
+    for (int i = 0; i < 200; ++i) {
+        probes.push_back({&fired, (i * 7919) % 1000});
+    }
+    for (auto& probe: probes) {
+        // Expired already, fire in order of delay
+        handles.push_back(reactor.addTimer(std::chrono::milliseconds{probe.delay} - std::chrono::seconds{1}, probe));
+    }
+    for (std::size_t i = 0; i < handles.size(); i += 3) {
+        ASSERT_TRUE( reactor.cancelTimer(handles[i]) );
+    }
+    reactor.poll(0);
+    ASSERT_EQ( reactor.pendingTimers(), 0u );
+    ASSERT_EQ( fired.size(), 200u - 67u );
+    ASSERT_TRUE( std::is_sorted(fired.begin(), fired.end()) );
+}
+
+TEST(Socket, IoUring)
+{
+    std::unique_ptr< IoUring > ring;
+    std::unique_ptr< IoUringBufferRing > buffers;
+    try {
+        ring = std::make_unique< IoUring >(64);
+        buffers = std::make_unique< IoUringBufferRing >(*ring, 1, 8, 64);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    }
+
+    // Multishot accept
+    auto listener = Socket::create(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE( bind(listener, IPv4::Endpoint{IPv4::Address::loopback(), 0}) );
+    ASSERT_TRUE( listen(listener) );
+    IPv4::Endpoint listenerEndpoint;
+    socklen_t size = listenerEndpoint.size();
+    ::getsockname(listener.native(), listenerEndpoint.data(), &size);
+
+    constexpr std::uint64_t AcceptId = 1;
+    ASSERT_TRUE( ring->acceptMultishot(listener, AcceptId) );
+    ASSERT_EQ( ring->submit(), 1 );
+
+    std::vector< Socket > clients;
+    for (int i = 0; i < 3; ++i) {
+        clients.push_back(Socket::create(AF_INET, SOCK_STREAM, 0));
+        ASSERT_TRUE( connect(clients.back(), listenerEndpoint) );
+    }
+    std::vector< Socket > accepted;
+    while (accepted.size() < 3 && !HasFatalFailure()) {
+        ASSERT_GE( ring->submit(1, 1000), 0 );
+        ring->complete([&](const IoUringCompletion& completion) {
+            ASSERT_EQ( completion.userData(), AcceptId );
+            ASSERT_GE( completion.result(), 0 );
+            ASSERT_TRUE( completion.more() );
+            accepted.emplace_back(completion.result());
+        });
+    }
+
+    // Send through ring, receive through multishot receive into provided buffers,
+    // more datagrams than buffers
+    IPv4::Endpoint receiverEndpoint;
+    auto receiver = bindLoopback(receiverEndpoint);
+    auto sender = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_TRUE( connect(sender, receiverEndpoint) );
+
+    constexpr std::uint64_t RecvId = 2;
+    constexpr std::uint64_t SendId = 3;
+    ASSERT_TRUE( ring->recvMultishot(receiver, buffers->group(), RecvId) );
+    ASSERT_EQ( ring->submit(), 1 );
+
+    constexpr std::size_t Count = 20;
+    std::vector< std::string > payloads;
+    for (std::size_t i = 0; i < Count; ++i) {
+        payloads.push_back("datagram-" + std::to_string(i));
+    }
+
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    while (received < Count && !HasFatalFailure()) {
+        // Keep less datagrams in flight than buffers
+        while (sent < Count && sent < received + 4) {
+            ASSERT_TRUE( ring->send(sender, payloads[sent].data(), payloads[sent].size(), SendId) );
+            sent += 1;
+        }
+        ASSERT_GE( ring->submit(1, 1000), 0 );
+        ring->complete([&](const IoUringCompletion& completion) {
+            if (completion.userData() == SendId) {
+                ASSERT_GT( completion.result(), 0 );
+                return;
+            }
+            ASSERT_EQ( completion.userData(), RecvId );
+            ASSERT_TRUE( completion.hasBuffer() );
+            ASSERT_TRUE( completion.more() );
+            auto data = buffers->buffer(completion);
+            ASSERT_EQ( std::string(bufferCast< const char* >(data), bufferSize(data)), payloads[received] );
+            buffers->recycle(completion);
+            received += 1;
+        });
+    }
+
+    ASSERT_TRUE( ring->cancel(RecvId, 0) );
+    ASSERT_TRUE( ring->cancel(AcceptId, 0) );
+    ASSERT_EQ( ring->submit(), 2 );
+}
+
+TEST(Socket, IoUringOverflow)
+{
+    // Completion queue of 2 entries, more completions than it fits
+    std::unique_ptr< IoUring > ring;
+    try {
+        ring = std::make_unique< IoUring >(1);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    }
+
+    IPv4::Endpoint receiverEndpoint;
+    auto receiver = bindLoopback(receiverEndpoint);
+    auto sender = Socket::create(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_TRUE( connect(sender, receiverEndpoint) );
+
+    constexpr std::size_t Count = 16;
+    for (std::size_t i = 0; i < Count; ++i) {
+        // Full submission queue is submitted on acquire
+        ASSERT_TRUE( ring->send(sender, "x", 1, i) );
+    }
+    ASSERT_EQ( ring->submit(), 1 );
+    ASSERT_TRUE( ring->overflow() );
+
+    std::vector< std::uint64_t > completed;
+    ASSERT_EQ( ring->complete([&](const IoUringCompletion& completion) {
+        ASSERT_EQ( completion.result(), 1 );
+        completed.push_back(completion.userData());
+    }), Count );
+    ASSERT_FALSE( ring->overflow() );
+    for (std::size_t i = 0; i < Count; ++i) {
+        ASSERT_EQ( completed[i], i );
+    }
+}
+
+TEST(Socket, ReusePortGroup)
+{
+    // Cpu steering, all datagrams are processed on CPU 0 (loopback), socket 1 takes them
+    ReusePortGroupOptions options;
+    options.shards = 2;
+    options.steering = ShardSteering::Cpu;
+    options.cpus = {1, 0};
+    std::unique_ptr< ReusePortGroup > group;
+    try {
+        group = std::make_unique< ReusePortGroup >(IPv4::Endpoint{IPv4::Address::loopback(), 0}, options);
+    } catch (const SocketError& e) {
+        GTEST_SKIP() << e.what();
+    }
+    IPv4::Endpoint endpoint;
+    socklen_t size = endpoint.size();
+    ::getsockname(group->socket(0).native(), endpoint.data(), &size);
+
+    std::thread{[&endpoint] {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(0, &set);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+        auto sender = Socket::create(AF_INET, SOCK_DGRAM, 0);
+        for (int i = 0; i < 10; ++i) {
+            sendto(sender, "x", 1, endpoint.data(), endpoint.size());
+        }
+    }}.join();
+    char buffer[16];
+    std::size_t received[2] = {0, 0};
+    for (std::size_t i = 0; i < 2; ++i) {
+        while (recv(group->socket(i), buffer, sizeof(buffer))) {
+            received[i] += 1;
+        }
+    }
+    ASSERT_EQ( received[0], 0u );
+    ASSERT_EQ( received[1], 10u );
+
+    // Hash steering, flows are distributed between workers
+    options.steering = ShardSteering::Hash;
+    options.cpus.clear();
+    group = std::make_unique< ReusePortGroup >(IPv4::Endpoint{IPv4::Address::loopback(), 0}, options);
+    size = endpoint.size();
+    ::getsockname(group->socket(0).native(), endpoint.data(), &size);
+
+    // Running workers are replaced on restart
+    group->start([](std::size_t, Socket&) {});
+
+    std::atomic< std::size_t > counts[2] = {};
+    group->start([&counts](std::size_t index, Socket& socket) {
+        char buffer[16];
+        while (recv(socket, buffer, sizeof(buffer))) {
+            counts[index].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    constexpr std::size_t Flows = 32;
+    for (std::size_t i = 0; i < Flows; ++i) {
+        auto flow = Socket::create(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_TRUE( sendto(flow, "x", 1, endpoint.data(), endpoint.size()) );
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (counts[0] + counts[1] < Flows && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    group->stop();
+    ASSERT_EQ( counts[0] + counts[1], Flows );
+    ASSERT_GT( counts[0].load(), 0u );
+    ASSERT_GT( counts[1].load(), 0u );
+}
+
+TEST(Socket, ZeroCopySender)
+{
+    auto listener = Socket::create(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE( bind(listener, IPv4::Endpoint{IPv4::Address::loopback(), 0}) );
+    ASSERT_TRUE( listen(listener) );
+    IPv4::Endpoint endpoint;
+    socklen_t size = endpoint.size();
+    ::getsockname(listener.native(), endpoint.data(), &size);
+
+    auto sender = Socket::create(AF_INET, SOCK_STREAM, 0);
+    ASSERT_TRUE( connect(sender, endpoint) );
+    Socket receiver = accept(listener).getSocket();
+
+    constexpr std::size_t ChunkSize = 64 * 1024;
+    constexpr std::size_t Chunks = 32;
+    std::size_t receivedBytes = 0;
+    std::thread reader{[&receiver, &receivedBytes] {
+        std::vector< char > buffer(ChunkSize);
+        while (receivedBytes < ChunkSize * Chunks) {
+            auto result = recv(receiver, buffer.data(), buffer.size());
+            if (!result) {
+                break;
+            }
+            for (std::size_t i = 0; i < result.bytes(); ++i) {
+                if (buffer[i] != char((receivedBytes + i) / ChunkSize)) {
+                    return;
+                }
+            }
+            receivedBytes += result.bytes();
+        }
+    }};
+
+    // Loopback always copies, sender falls back after `copiedLimit` copied sends
+    ZeroCopySenderOptions options;
+    options.maxPending = 16;
+    options.copiedLimit = 4;
+    ZeroCopySender zerocopy{sender, options};
+
+    std::vector< std::vector< char > > buffers;
+    for (std::size_t i = 0; i < Chunks; ++i) {
+        buffers.emplace_back(ChunkSize, char(i));
+    }
+
+    std::vector< std::uint64_t > completed;
+    auto onComplete = [&completed](std::uint64_t token, bool copied) {
+        ASSERT_TRUE( copied );
+        completed.push_back(token);
+    };
+    for (std::size_t i = 0; i < Chunks; ++i) {
+        std::size_t offset = 0;
+        while (offset < ChunkSize) {
+            auto result = zerocopy.send(buffers[i].data() + offset, ChunkSize - offset, i);
+            if (!result) {
+                ASSERT_EQ( result.native(), ENOBUFS );
+                zerocopy.wait(1000);
+                zerocopy.complete(onComplete);
+                continue;
+            }
+            offset += result.bytes();
+        }
+    }
+    while (zerocopy.pending() > 0 && zerocopy.wait(1000)) {
+        zerocopy.complete(onComplete);
+    }
+    reader.join();
+
+    ASSERT_EQ( receivedBytes, ChunkSize * Chunks );
+    ASSERT_EQ( zerocopy.pending(), 0u );
+    // Token reported per send call, partial sends report it more than once
+    ASSERT_GE( completed.size(), Chunks );
+    ASSERT_TRUE( std::is_sorted(completed.begin(), completed.end()) );
+    ASSERT_EQ( completed.front(), 0u );
+    ASSERT_EQ( completed.back(), Chunks - 1 );
+
+    const auto& statistics = zerocopy.statistics();
+    if (statistics.zerocopySends > 0) {
+        ASSERT_FALSE( zerocopy.zerocopy() );
+        ASSERT_GE( statistics.copied, options.copiedLimit );
+    }
+    ASSERT_LT( statistics.zerocopySends, statistics.sends );
+}